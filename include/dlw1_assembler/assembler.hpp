@@ -1,11 +1,155 @@
 #ifndef ASSEMBLER_HPP
 #define ASSEMBLER_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
+#include "dlw1_assembler/encoder.hpp"
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_assembler/program_image.hpp"
+#include "dlw1_assembler/statement.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
+
+struct AssemblyStats {
+  std::size_t lines = 0;
+  std::size_t parsed_lines = 0;    // Lines lexed and parsed (cache misses)
+  std::size_t encoded_lines = 0;   // Lines whose bytes were (re)computed
+  std::size_t changed_labels = 0;  // Labels defined or moved since last run
+  std::size_t eliminated_instructions = 0;  // Removed by the optimizer
+  std::size_t image_size = 0;
+};
+
+enum class OutputFormat : uint8_t {
+  IMAGE,   // Flat program image, ready to load
+  OBJECT,  // Relocatable object file for the linker
+  SECTIONED,  // Program image with a header, entry point and segment table
+};
+
+// Assembles DLW-1 source into a flat program image or a relocatable object.
+// An instance caches the parsed statement and encoded bytes of every distinct
+// source line, so re-assembling an edited file only lexes and parses the
+// changed lines and only re-encodes label references whose addresses moved.
 class Assembler {
+ private:
+  struct Encoding {
+    std::vector<uint8_t> bytes{};
+    bool encoded = false;
+    uint16_t address = 0;  // Layout the bytes were encoded against
+    uint16_t target = 0;
+  };
+
+  struct CachedLine {
+    Statement statement{};
+    // A line that references a label encodes differently wherever it is
+    // placed, so each of its occurrences in the source keeps its own bytes;
+    // any other line has a single encoding, shared by every occurrence
+    std::vector<Encoding> encodings = std::vector<Encoding>(1);
+    std::size_t occurrences = 0;  // Placed so far in the current run
+    std::size_t generation = 0;   // Last run that used this line
+  };
+
+  struct PlacedLine {
+    CachedLine* line = nullptr;
+    std::size_t encoding = 0;  // Index into line->encodings
+    std::size_t line_number = 0;
+    Section section = Section::TEXT;
+    uint32_t address = 0;  // Section offset, then flat image address
+
+    [[nodiscard]] const std::vector<uint8_t>& Bytes() const noexcept {
+      return line->encodings[encoding].bytes;
+    }
+  };
+
+  struct StringHash {
+    using is_transparent = void;
+    std::size_t operator()(const std::string_view text) const noexcept {
+      return std::hash<std::string_view>{}(text);
+    }
+  };
+
+  template <typename T>
+  using StringMap =
+      std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+  StringMap<CachedLine> line_cache;
+  StringMap<uint16_t> symbols;
+  std::vector<PlacedLine> placed_lines;
+  std::deque<CachedLine> optimized_lines;  // Rewrites of this run's lines
+  std::array<uint32_t, SECTION_COUNT> section_sizes{};
+  std::size_t generation = 0;
+  std::size_t live_lines = 0;  // Cached lines used by the current run
+  AssemblyStats stats;
+  bool optimize = false;
+  JumpForm jump_form = JumpForm::RELATIVE;
+  bool read_only_text = false;
+  std::string symbol_map_path;  // Empty when no symbol map is written
+
+  // Returns zero-filled storage of the requested size for the image
+  using ImageAllocator = std::function<std::span<uint8_t>(std::size_t)>;
+
+  // Places the next occurrence of a source line
+  [[nodiscard]] PlacedLine PlaceLine(std::string_view text,
+                                     std::size_t line_number);
+  void ReadLines(std::string_view source);
+  // Runs the peephole optimizer without touching the cached statements
+  void Optimize();
+  // Places every line; relocatable layouts keep section-relative addresses
+  void Layout(bool relocatable);
+  [[nodiscard]] std::size_t Encode(bool relocatable);
+  void Emit(std::span<uint8_t> image) const noexcept;
+  void Assemble(std::string_view source, const ImageAllocator& allocate);
+  [[nodiscard]] ObjectFile BuildObject() const;
+  // Segments of the bytes lines placed in the last flat image, which they
+  // view
+  [[nodiscard]] ProgramImage BuildImage(std::span<const uint8_t> image) const;
+  void Finish();
+
  public:
-  static void Assemble(const std::string& program_file_path);
+  // Assembles a whole program, reusing work from previous calls
+  [[nodiscard]] std::vector<uint8_t> Assemble(std::string_view source);
+  // Assembles a program into a relocatable object, leaving every label
+  // reference to the linker
+  [[nodiscard]] ObjectFile AssembleObject(std::string_view source);
+  // Assembles a program into a serialized sectioned image. Every run of
+  // bytes the program places becomes a segment, so gaps left by .org take
+  // no space. Execution starts at the label _start, if defined, else at 0.
+  [[nodiscard]] std::vector<uint8_t> AssembleImage(std::string_view source);
+  // Maps every byte-producing line of the last assembled image back to its
+  // source. Must be given the same source as the preceding Assemble().
+  [[nodiscard]] DebugInfo BuildDebugInfo(std::string_view source,
+                                         std::string file_name) const;
+  // Reads and writes through memory mappings where the files allow it. A
+  // path of "-" selects stdin or stdout.
+  void AssembleFile(const std::string& program_file_path,
+                    const std::string& output_file_path,
+                    OutputFormat format = OutputFormat::IMAGE);
+  // Re-assembles the program every time the source file changes
+  [[noreturn]] void Watch(const std::string& program_file_path,
+                          const std::string& output_file_path,
+                          OutputFormat format = OutputFormat::IMAGE);
+
+  // Enables the peephole optimizer between parsing and layout
+  void SetOptimization(bool enabled) noexcept;
+  // Chooses between PC-relative (the default) and absolute in-bank
+  // encodings for jumps to labels
+  void SetPositionIndependent(bool enabled) noexcept;
+  // Marks the text segments of sectioned images read-only, so the emulator
+  // write-protects the banks holding them. Text in a bank that also holds
+  // data stays writable, with a warning, as the code must store there.
+  void SetReadOnlyText(bool enabled) noexcept;
+  // Writes a symbol map next to every image AssembleFile() produces; an
+  // empty path disables it
+  void SetSymbolMapPath(std::string path) noexcept;
+
+  [[nodiscard]] const AssemblyStats& GetStats() const noexcept;
 };
 
 #endif
@@ -0,0 +1,52 @@
+#ifndef ENCODER_HPP
+#define ENCODER_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_assembler/statement.hpp"
+
+// Encoding of jumps to a bare label. Both forms take one instruction and
+// reach every address of the current bank, since the PC wraps within it, so
+// the choice never changes code size.
+enum class JumpForm : uint8_t {
+  RELATIVE,  // Offset from the next instruction; position independent
+  ABSOLUTE,  // In-bank address of the target
+};
+
+class Encoder {
+ private:
+  [[nodiscard]] static uint8_t OpcodeBits(TokenType mnemonic) noexcept;
+  [[nodiscard]] static int32_t RelativeOffset(uint16_t address,
+                                              uint16_t target) noexcept;
+  [[nodiscard]] static uint16_t RelativeField(int32_t offset) noexcept;
+
+ public:
+  static constexpr uint16_t INSTRUCTION_SIZE = 2;
+
+  // Number of bytes the statement occupies in the program image
+  [[nodiscard]] static uint16_t Size(const Statement& statement) noexcept;
+
+  // Appends the bytes of a statement placed at the flat image address
+  // `address` (bank * 256 + offset). `target` is the flat address of the
+  // label the statement references, if any.
+  static void Encode(const Statement& statement, uint16_t address,
+                     uint16_t target, JumpForm jump_form,
+                     std::vector<uint8_t>& bytes);
+  [[nodiscard]] static uint16_t EncodeInstruction(const Statement& statement,
+                                                  uint16_t address,
+                                                  uint16_t target,
+                                                  JumpForm jump_form);
+
+  // Kind of relocation a label reference in the statement needs
+  [[nodiscard]] static RelocationType RelocationFor(
+      const Statement& statement, JumpForm jump_form) noexcept;
+  // Rewrites the label field of the instruction at `address` to refer to
+  // `target`. Relative jumps must stay within one bank.
+  static void Relocate(RelocationType type, uint16_t address, uint16_t target,
+                       std::span<uint8_t, INSTRUCTION_SIZE> instruction);
+};
+
+#endif
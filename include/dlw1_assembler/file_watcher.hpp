@@ -0,0 +1,27 @@
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <filesystem>
+#include <string>
+
+// Blocks until a file is rewritten. Uses inotify on Linux and falls back to
+// polling the modification time elsewhere.
+class FileWatcher {
+ private:
+  std::filesystem::path path;
+  std::filesystem::file_time_type last_write_time;
+  int inotify_fd;
+
+ public:
+  explicit FileWatcher(const std::string& file_path);
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+  FileWatcher(FileWatcher&&) = delete;
+  FileWatcher& operator=(FileWatcher&&) = delete;
+
+  void WaitForChange();
+};
+
+#endif
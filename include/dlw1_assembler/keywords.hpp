@@ -0,0 +1,155 @@
+#ifndef KEYWORDS_HPP
+#define KEYWORDS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "dlw1_assembler/token.hpp"
+
+// Reserved words of the assembly language (mnemonics, directives and
+// registers), classified through a perfect hash generated at compile time.
+// Every keyword lands in its own slot, so a lookup costs one hash and at most
+// one case-insensitive compare.
+class Keywords {
+ private:
+  struct Entry {
+    std::string_view text;  // Lowercase spelling
+    TokenType type;
+  };
+
+  static constexpr std::array<Entry, 22> ENTRIES{{
+      {.text = "add", .type = TokenType::ADD},
+      {.text = "sub", .type = TokenType::SUB},
+      {.text = "load", .type = TokenType::LOAD},
+      {.text = "store", .type = TokenType::STORE},
+      {.text = "mov", .type = TokenType::MOV},
+      {.text = "bank", .type = TokenType::BANK},
+      {.text = "jump", .type = TokenType::JUMP},
+      {.text = "jumpz", .type = TokenType::JUMPZ},
+      {.text = "jumpnz", .type = TokenType::JUMPNZ},
+      {.text = "jumpn", .type = TokenType::JUMPN},
+      {.text = "halt", .type = TokenType::HALT},
+      {.text = ".org", .type = TokenType::DIRECTIVE_ORG},
+      {.text = ".byte", .type = TokenType::DIRECTIVE_BYTE},
+      {.text = ".word", .type = TokenType::DIRECTIVE_WORD},
+      {.text = ".data", .type = TokenType::DIRECTIVE_DATA},
+      {.text = ".text", .type = TokenType::DIRECTIVE_TEXT},
+      {.text = ".global", .type = TokenType::DIRECTIVE_GLOBAL},
+      {.text = ".extern", .type = TokenType::DIRECTIVE_EXTERN},
+      {.text = "ra", .type = TokenType::REGISTER},
+      {.text = "rb", .type = TokenType::REGISTER},
+      {.text = "rc", .type = TokenType::REGISTER},
+      {.text = "rd", .type = TokenType::REGISTER},
+  }};
+
+  static constexpr std::size_t TABLE_SIZE = 64;  // Must be a power of two
+  static constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+  static constexpr std::size_t MIN_LENGTH = [] {
+    std::size_t min_length = ENTRIES[0].text.size();
+    for (const Entry& entry : ENTRIES) {
+      min_length = entry.text.size() < min_length ? entry.text.size()
+                                                  : min_length;
+    }
+    return min_length;
+  }();
+  static constexpr std::size_t MAX_LENGTH = [] {
+    std::size_t max_length = 0;
+    for (const Entry& entry : ENTRIES) {
+      max_length = entry.text.size() > max_length ? entry.text.size()
+                                                  : max_length;
+    }
+    return max_length;
+  }();
+
+  // Folds ASCII letters to lowercase. Keywords only contain letters and '.',
+  // which is unaffected, so folding never makes a non-keyword match.
+  [[nodiscard]] static constexpr char Fold(const char c) noexcept {
+    return static_cast<char>(static_cast<unsigned char>(c) | 0x20U);
+  }
+
+  // Seeded FNV-1a over the case-folded text
+  [[nodiscard]] static constexpr uint32_t Hash(const std::string_view text,
+                                               const uint32_t seed) noexcept {
+    uint32_t hash = 2166136261U ^ seed;
+    for (const char c : text) {
+      hash ^= static_cast<unsigned char>(Fold(c));
+      hash *= 16777619U;
+    }
+    return hash ^ (hash >> 16U);
+  }
+
+  [[nodiscard]] static constexpr std::size_t Slot(
+      const std::string_view text, const uint32_t seed) noexcept {
+    return Hash(text, seed) & (TABLE_SIZE - 1);
+  }
+
+  // Searches for the first seed under which no two keywords collide
+  [[nodiscard]] static consteval uint32_t FindSeed() {
+    for (uint32_t seed = 0;; ++seed) {
+      std::array<bool, TABLE_SIZE> used{};
+      bool perfect = true;
+      for (const Entry& entry : ENTRIES) {
+        const std::size_t slot = Slot(entry.text, seed);
+        if (used.at(slot)) {
+          perfect = false;
+          break;
+        }
+        used.at(slot) = true;
+      }
+      if (perfect) {
+        return seed;
+      }
+    }
+  }
+
+  [[nodiscard]] static consteval std::array<uint8_t, TABLE_SIZE> BuildSlots(
+      const uint32_t seed) {
+    std::array<uint8_t, TABLE_SIZE> slots{};
+    slots.fill(EMPTY_SLOT);
+    for (std::size_t i = 0; i < ENTRIES.size(); ++i) {
+      slots.at(Slot(ENTRIES.at(i).text, seed)) = static_cast<uint8_t>(i);
+    }
+    return slots;
+  }
+
+  // Defined below the class, once the generator functions are complete
+  static const uint32_t SEED;
+  static const std::array<uint8_t, TABLE_SIZE> SLOTS;
+
+ public:
+  // Returns the token type of a reserved word, or nothing for any other word
+  [[nodiscard]] static constexpr std::optional<TokenType> Lookup(
+      const std::string_view text) noexcept {
+    if (text.size() < MIN_LENGTH || text.size() > MAX_LENGTH) {
+      return std::nullopt;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    const uint8_t index = SLOTS[Slot(text, SEED)];
+    if (index == EMPTY_SLOT) {
+      return std::nullopt;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    const Entry& entry = ENTRIES[index];
+    if (entry.text.size() != text.size()) {
+      return std::nullopt;
+    }
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      if (Fold(text[i]) != entry.text[i]) {
+        return std::nullopt;
+      }
+    }
+    return entry.type;
+  }
+};
+
+inline constexpr uint32_t Keywords::SEED = Keywords::FindSeed();
+inline constexpr std::array<uint8_t, Keywords::TABLE_SIZE> Keywords::SLOTS =
+    Keywords::BuildSlots(Keywords::SEED);
+
+#endif
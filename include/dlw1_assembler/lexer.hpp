@@ -3,6 +3,7 @@
 
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "dlw1_assembler/linestream.hpp"
@@ -10,10 +11,7 @@
 
 class Lexer {
  private:
-  static constexpr std::size_t REGISTER_NAME_LENGTH = 2;
-  static constexpr std::string_view VALID_REGISTER_SUFFIXES = "abcdABCD";
-
-  static void CleanLine(std::string& line);
+  [[nodiscard]] static std::string_view CleanLine(std::string_view line);
   [[nodiscard]] static Token TokenizeNumber(
       LineStream& linestream, const std::size_t current_line_number);
   [[nodiscard]] static Token TokenizeWord(
@@ -24,6 +22,9 @@ class Lexer {
  public:
   [[nodiscard]] static std::vector<Token> Tokenize(
       std::stringstream program_contents);
+  // Tokenizes a single source line, without a trailing END_OF_FILE token
+  [[nodiscard]] static std::vector<Token> TokenizeLine(
+      std::string_view line, std::size_t line_number);
 };
 
 #endif
@@ -0,0 +1,71 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Path that selects stdin for input files and stdout for output files
+inline constexpr std::string_view STANDARD_STREAM_PATH = "-";
+
+// Read-only view of a whole file. Regular files are memory-mapped and read
+// straight from the page cache; pipes, character devices and stdin are read
+// into a buffer instead.
+class InputFile {
+ private:
+  std::string buffer;
+  const char* data;
+  std::size_t size;
+  bool mapped;
+
+ public:
+  explicit InputFile(const std::string& file_path);
+  ~InputFile();
+
+  InputFile(const InputFile&) = delete;
+  InputFile& operator=(const InputFile&) = delete;
+  InputFile(InputFile&&) = delete;
+  InputFile& operator=(InputFile&&) = delete;
+
+  [[nodiscard]] std::string_view View() const noexcept;
+};
+
+// Fixed-size, writable file contents. Regular files are resized with their
+// disk blocks allocated up front and memory-mapped, so callers write directly
+// into the page cache; other outputs are buffered and written out by
+// Commit(). A full disk is reported when the file is opened.
+class OutputFile {
+ private:
+  std::string path;
+  std::vector<uint8_t> buffer;
+  uint8_t* data;
+  std::size_t size;
+  int file_descriptor;
+  bool mapped;
+
+  void Close() noexcept;
+
+ public:
+  OutputFile(const std::string& file_path, std::size_t file_size);
+  ~OutputFile();
+
+  OutputFile(const OutputFile&) = delete;
+  OutputFile& operator=(const OutputFile&) = delete;
+  OutputFile(OutputFile&&) = delete;
+  OutputFile& operator=(OutputFile&&) = delete;
+
+  [[nodiscard]] std::span<uint8_t> Data() noexcept;
+  // Flushes the contents to the file, reporting any write error. A durable
+  // commit also waits until they reach the storage device, e.g. before the
+  // file is renamed over one that must survive a crash.
+  void Commit(bool durable = false);
+};
+
+// Waits until the directory entry of a file that was just created or renamed
+// reaches the storage device, so the file keeps its name after a crash
+void SyncDirectoryEntry(const std::string& file_path);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef OBJECT_FILE_HPP
+#define OBJECT_FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+enum class Section : uint8_t { TEXT, DATA };
+
+inline constexpr std::size_t SECTION_COUNT = 2;
+
+enum class SymbolBinding : uint8_t {
+  LOCAL,   // Visible to relocations of the defining object only
+  GLOBAL,  // Exported with .global
+  EXTERN,  // Imported with .extern, defined by another object
+};
+
+enum class RelocationType : uint8_t {
+  ABSOLUTE_8,  // Instruction immediate holds the target's in-bank address
+  RELATIVE_9,  // Jump offset from the next instruction to the target
+};
+
+struct ObjectSymbol {
+  std::string name;
+  SymbolBinding binding = SymbolBinding::LOCAL;
+  Section section = Section::TEXT;
+  uint16_t offset = 0;  // Section offset, unused for EXTERN symbols
+};
+
+struct Relocation {
+  Section section = Section::TEXT;
+  uint16_t offset = 0;  // Section offset of the instruction to patch
+  RelocationType type = RelocationType::ABSOLUTE_8;
+  uint16_t symbol = 0;  // Index into the symbol table
+};
+
+// Relocatable output of the assembler. Sections are assembled as if they
+// started at address 0; every label reference is left to the linker as a
+// relocation, since jump offsets depend on where the sections end up.
+//
+// Serialized layout, big-endian like the rest of the toolchain:
+//   "DLWO" version:u8
+//   text_size:u32 data_size:u32 symbol_count:u16 relocation_count:u16
+//   text bytes, data bytes
+//   symbols:     name_length:u8 name binding:u8 section:u8 offset:u16
+//   relocations: section:u8 offset:u16 type:u8 symbol:u16
+struct ObjectFile {
+  static constexpr std::array<uint8_t, 4> MAGIC{'D', 'L', 'W', 'O'};
+  static constexpr uint8_t VERSION = 1;
+
+  std::array<std::vector<uint8_t>, SECTION_COUNT> sections;
+  std::vector<ObjectSymbol> symbols;
+  std::vector<Relocation> relocations;
+
+  [[nodiscard]] std::vector<uint8_t>& Contents(Section section) noexcept;
+  [[nodiscard]] const std::vector<uint8_t>& Contents(
+      Section section) const noexcept;
+
+  [[nodiscard]] std::size_t SerializedSize() const noexcept;
+  // Writes the object into a buffer of exactly SerializedSize() bytes
+  void Serialize(std::span<uint8_t> bytes) const;
+  [[nodiscard]] static ObjectFile Deserialize(std::span<const uint8_t> bytes);
+  [[nodiscard]] static bool IsObject(std::span<const uint8_t> bytes) noexcept;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef OPTIMIZER_HPP
+#define OPTIMIZER_HPP
+
+#include <cstddef>
+#include <deque>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "dlw1_assembler/statement.hpp"
+
+struct OptimizationResult {
+  // Replacement statements by program index, in ascending index order.
+  // Eliminated instructions become EMPTY statements that keep their label.
+  std::vector<std::pair<std::size_t, Statement>> rewrites;
+  std::size_t eliminated_instructions = 0;
+  // The program addresses code or data by number, so nothing was removed
+  bool numeric_addresses = false;
+};
+
+// Peephole optimizer over parsed statements. Rewrites are applied within
+// straight-line windows only, since a label may be reached from elsewhere,
+// and never change the PSW flags a later instruction can read. Instructions
+// are only removed after the last bank switch or .org, as removing one
+// moves every later address, and never from programs that jump to or access
+// numeric or register addresses:
+//   mov rX, rX                        -> (removed)
+//   add/sub rS, #0, rD                -> mov rS, rD or (removed), PSW dead
+//   store rX, #a / load rY, #a        -> store rX, #a / mov rX, rY
+//   load rX, #a / store rX, #a        -> load rX, #a
+//   store rX, #a / store rY, #a       -> store rY, #a
+//   add/sub rS, #a, rD / add/sub rD, #b, rD -> add rS, #(a +/- b), rD
+class Optimizer {
+ private:
+  std::span<const Statement* const> program;
+  std::vector<const Statement*> current;
+  std::deque<Statement> replacements;
+  std::size_t eliminated = 0;
+  std::size_t fixed_layout_end = 0;  // Removals must come at or after this
+
+  explicit Optimizer(std::span<const Statement* const> program);
+
+  [[nodiscard]] const Statement& At(std::size_t index) const;
+  [[nodiscard]] std::size_t NextInstruction(std::size_t index) const;
+  [[nodiscard]] bool FlagsLiveAfter(std::size_t index) const;
+  [[nodiscard]] bool Removable(std::size_t index) const noexcept;
+  void Replace(std::size_t index, Statement statement);
+  void Remove(std::size_t index);
+
+  [[nodiscard]] bool RewriteSingle(std::size_t index);
+  [[nodiscard]] bool RewritePair(std::size_t first, std::size_t second);
+
+  [[nodiscard]] static bool DependsOnLayout(const Statement& statement);
+
+ public:
+  [[nodiscard]] static OptimizationResult Optimize(
+      std::span<const Statement* const> program);
+};
+
+#endif
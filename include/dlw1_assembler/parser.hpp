@@ -0,0 +1,47 @@
+#ifndef PARSER_HPP
+#define PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "dlw1_assembler/statement.hpp"
+#include "dlw1_assembler/token.hpp"
+
+class Parser {
+ private:
+  std::span<const Token> tokens;
+  std::size_t position;
+  std::size_t line_number;
+
+  [[nodiscard]] bool EndOfLine() const noexcept;
+  [[nodiscard]] const Token& Peek() const noexcept;
+  const Token& Get() noexcept;
+  bool Accept(TokenType type) noexcept;
+  const Token& Expect(TokenType type, std::string_view description);
+  [[noreturn]] void Error(const std::string& message) const;
+
+  [[nodiscard]] int32_t ParseSignedNumber();
+  [[nodiscard]] Operand ParseOperand();
+  void ValidateDirective(const Statement& statement) const;
+  void ValidateInstruction(const Statement& statement) const;
+  void CheckRange(int32_t value, int32_t min, int32_t max,
+                  std::string_view description) const;
+
+ public:
+  Parser(std::span<const Token> tokens, std::size_t line_number)
+      : tokens(tokens), position(0), line_number(line_number) {}
+
+  // Parses the tokens of a single source line (without END_OF_FILE)
+  [[nodiscard]] Statement Parse();
+
+  [[nodiscard]] static Statement ParseLine(std::span<const Token> tokens,
+                                           std::size_t line_number);
+  [[nodiscard]] static int32_t ParseNumber(std::string_view text,
+                                           std::size_t line_number);
+  [[nodiscard]] static uint8_t ParseRegister(std::string_view text) noexcept;
+};
+
+#endif
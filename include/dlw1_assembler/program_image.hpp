@@ -0,0 +1,51 @@
+#ifndef PROGRAM_IMAGE_HPP
+#define PROGRAM_IMAGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Bytes placed at a flat address, bank << 8 | in-bank address. A segment may
+// run on into the following banks.
+struct ImageSegment {
+  static constexpr uint8_t READ_ONLY = 0b1;  // Loader write-protects its banks
+
+  uint16_t address = 0;
+  uint8_t flags = 0;
+  std::span<const uint8_t> bytes;
+};
+
+// Loadable program that says where its bytes go, so sparse .org layouts need
+// no zero padding on disk, and where execution starts. Segments view memory
+// the image does not own: the assembler's output, or the deserialized file.
+//
+// Serialized layout, big-endian like the rest of the toolchain:
+//   "DLWI" version:u8 entry:u16 segment_count:u16 checksum:u32
+//   segments: address:u16 length:u32 flags:u8
+//   segment contents, in table order
+// The checksum is the Adler-32 of everything after the header.
+struct ProgramImage {
+  static constexpr std::array<uint8_t, 4> MAGIC{'D', 'L', 'W', 'I'};
+  static constexpr uint8_t VERSION = 1;
+  static constexpr std::size_t HEADER_SIZE = 4 + 1 + 2 + 2 + 4;
+  static constexpr std::size_t SEGMENT_SIZE = 2 + 4 + 1;
+  static constexpr std::size_t ADDRESS_SPACE = 0x10000;
+  // Largest valid image: every byte of the address space in its own segment
+  static constexpr std::size_t MAX_SIZE =
+      HEADER_SIZE + (UINT16_MAX * SEGMENT_SIZE) + ADDRESS_SPACE;
+
+  uint16_t entry = 0;  // Flat address of the first instruction
+  std::vector<ImageSegment> segments;
+
+  [[nodiscard]] std::size_t SerializedSize() const noexcept;
+  // Writes the image into a buffer of exactly SerializedSize() bytes
+  void Serialize(std::span<uint8_t> bytes) const;
+  // Checks the header, checksum and segment bounds. The segments view
+  // `bytes`, which must outlive the image.
+  [[nodiscard]] static ProgramImage Deserialize(std::span<const uint8_t> bytes);
+  [[nodiscard]] static bool IsImage(std::span<const uint8_t> bytes) noexcept;
+};
+
+#endif
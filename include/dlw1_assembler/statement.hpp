@@ -0,0 +1,62 @@
+#ifndef STATEMENT_HPP
+#define STATEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dlw1_assembler/token.hpp"
+
+enum class OperandType : uint8_t {
+  IMMEDIATE,  // #number or #label
+  NUMBER,     // Bare number (directive arguments)
+  REGISTER,
+  RELATIVE,   // (register +/- #number), or (+/- #number) for jumps
+  SYMBOL,     // Bare label reference (jump targets)
+};
+
+struct Operand {
+  static constexpr uint8_t NO_REGISTER = 0xFF;
+
+  OperandType type = OperandType::NUMBER;
+  uint8_t reg = NO_REGISTER;  // Register index (A = 0 ... D = 3)
+  int32_t value = 0;
+  std::string symbol{};  // Referenced label, empty for plain numbers
+};
+
+inline bool operator==(const Operand& lhs, const Operand& rhs) {
+  return lhs.type == rhs.type && lhs.reg == rhs.reg &&
+         lhs.value == rhs.value && lhs.symbol == rhs.symbol;
+}
+
+enum class StatementType : uint8_t {
+  EMPTY,  // Blank, comment-only or label-only line
+  DIRECTIVE,
+  INSTRUCTION,
+};
+
+// One parsed source line
+struct Statement {
+  std::string label{};  // Label defined on this line, empty if none
+  StatementType type = StatementType::EMPTY;
+  TokenType keyword = TokenType::END_OF_FILE;  // Mnemonic or directive
+  std::vector<Operand> operands{};
+  std::size_t line_number = 0;
+
+  // Label referenced by the statement, empty if it does not depend on layout
+  [[nodiscard]] std::string_view ReferencedSymbol() const noexcept {
+    if (type != StatementType::INSTRUCTION) {
+      return {};  // Symbol declarations name labels without using them
+    }
+    for (const Operand& operand : operands) {
+      if (!operand.symbol.empty()) {
+        return operand.symbol;
+      }
+    }
+    return {};
+  }
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SYMBOL_MAP_HPP
+#define SYMBOL_MAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dlw1_assembler/mapped_file.hpp"
+
+// Extension of the symbol map written next to a program image
+inline constexpr std::string_view SYMBOL_MAP_EXTENSION = ".dbg";
+
+struct DebugLine {
+  uint16_t address = 0;  // Image address, bank << 8 | in-bank address
+  uint16_t size = 0;     // Bytes the line assembled into
+  uint32_t line = 0;     // 1-based source line
+  std::string label{};   // Nearest label at or before the line
+  std::string text{};    // Source line without comment or extra spaces
+};
+
+// Source-level debug information the assembler writes next to a program
+// image, read back through SymbolMap.
+//
+// Serialized layout, big-endian like the rest of the toolchain:
+//   "DLWS" version:u8 line_count:u32 strings_size:u32
+//   lines:   address:u16 size:u16 line:u32 file:u32 label:u32 text:u32
+//   strings: length:u16 bytes
+// Lines are sorted by address and have a fixed size so they can be
+// binary-searched in place; file, label and text are offsets into strings.
+struct DebugInfo {
+  static constexpr std::array<uint8_t, 4> MAGIC{'D', 'L', 'W', 'S'};
+  static constexpr uint8_t VERSION = 1;
+
+  std::string file{};
+  std::vector<DebugLine> lines{};  // In ascending address order
+
+  [[nodiscard]] std::size_t SerializedSize() const;
+  // Writes the map into a buffer of exactly SerializedSize() bytes
+  void Serialize(std::span<uint8_t> bytes) const;
+};
+
+struct SourceLocation {
+  std::string_view file;
+  uint32_t line = 0;
+  std::string_view label;
+  std::string_view text;
+};
+
+// Read-only view of a serialized DebugInfo. Files are memory-mapped, so
+// loading a map costs a header check and lookups touch only the pages they
+// search. Returned locations point into the map and live as long as it does.
+class SymbolMap {
+ private:
+  std::unique_ptr<InputFile> file;  // Keeps the mapping alive
+  std::vector<uint8_t> buffer;      // Or owns the bytes directly
+  std::span<const uint8_t> lines;
+  std::span<const uint8_t> strings;
+  std::size_t line_count = 0;
+
+  void Parse(std::span<const uint8_t> bytes);
+  [[nodiscard]] uint16_t AddressAt(std::size_t index) const noexcept;
+  [[nodiscard]] std::string_view StringAt(uint32_t offset) const;
+  [[nodiscard]] std::optional<SourceLocation> Resolve(std::size_t index,
+                                                      uint16_t address) const;
+  [[nodiscard]] std::size_t UpperBound(std::size_t first,
+                                       uint16_t address) const noexcept;
+
+ public:
+  // Views bytes the caller keeps alive
+  explicit SymbolMap(std::span<const uint8_t> bytes);
+  explicit SymbolMap(std::vector<uint8_t> bytes);
+  explicit SymbolMap(const std::string& file_path);
+
+  [[nodiscard]] std::size_t Size() const noexcept;
+
+  [[nodiscard]] std::optional<SourceLocation> Lookup(uint16_t address) const;
+  // Resolves many addresses in one ordered pass over the map; results are in
+  // the order of `addresses`
+  [[nodiscard]] std::vector<std::optional<SourceLocation>> Lookup(
+      std::span<const uint16_t> addresses) const;
+
+  [[nodiscard]] static bool IsSymbolMap(
+      std::span<const uint8_t> bytes) noexcept;
+};
+
+// Prints a location as "file:line text"
+std::ostream& operator<<(std::ostream& os, const SourceLocation& location);
+
+#endif
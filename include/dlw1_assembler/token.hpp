@@ -8,7 +8,7 @@
 enum class TokenType : uint8_t {
   COLON,
   COMMA,
-  DIRECTIVE,
+  DIRECTIVE,  // Unrecognized directive
   END_OF_FILE,
   HASH,
   IDENTIFIER,
@@ -18,6 +18,28 @@ enum class TokenType : uint8_t {
   PLUS,
   REGISTER,
   RPARENTHESES,
+
+  // Mnemonics
+  ADD,
+  BANK,
+  HALT,
+  JUMP,
+  JUMPN,
+  JUMPNZ,
+  JUMPZ,
+  LOAD,
+  MOV,
+  STORE,
+  SUB,
+
+  // Directives
+  DIRECTIVE_BYTE,
+  DIRECTIVE_DATA,
+  DIRECTIVE_EXTERN,
+  DIRECTIVE_GLOBAL,
+  DIRECTIVE_ORG,
+  DIRECTIVE_TEXT,
+  DIRECTIVE_WORD,
 };
 
 std::ostream& operator<<(std::ostream& os, const TokenType& type);
@@ -0,0 +1,99 @@
+#ifndef BANKED_MEMORY_HPP
+#define BANKED_MEMORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "config.hpp"
+#include "memory.hpp"
+
+// The memory a run loop specialized for a bank count executes against.
+//
+// Memory sizes its bank tables at run time and indexes them with the current
+// bank on every access. This view copies the tables into arrays sized at
+// compile time, so with one bank every index is the constant 0 and bank
+// switching compiles away entirely; with a few banks the tables stay in the
+// view instead of behind a vector. The bytes themselves stay in Memory, which
+// the view writes through to, so sharing, protection and watchpoints keep
+// working: anything the fast paths cannot handle falls back to Memory.
+//
+// The tables go stale when anything but the view changes Memory's banks,
+// e.g. Share() or SetAccess(); call Sync() after those.
+template <uint8_t NumBanks>
+class BankedMemory {
+  static_assert(NumBanks > 0);
+
+ private:
+  Memory& memory;
+  std::array<const Memory::Bank*, NumBanks> pages{};
+  // Banks only the memory references; null where writes take Memory's path
+  std::array<Memory::Bank*, NumBanks> banks{};
+  std::array<uint8_t, NumBanks> access{};
+  uint8_t curr_bank = 0;
+
+ public:
+  // `memory` must have NumBanks banks
+  explicit BankedMemory(Memory& memory) : memory{memory} { Sync(); }
+
+  void Sync() noexcept {
+    for (std::size_t bank = 0; bank < NumBanks; ++bank) {
+      pages[bank] = memory.pages[bank];
+      banks[bank] = memory.banks[bank].get();
+      access[bank] = memory.access[bank];
+    }
+    curr_bank = memory.curr_bank;
+  }
+
+  [[nodiscard]] uint8_t GetCurrentBank() const noexcept {
+    if constexpr (NumBanks == 1) {
+      return 0;
+    } else {
+      return curr_bank;
+    }
+  }
+
+  [[nodiscard]] uint8_t GetAccess(const uint8_t bank) const noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return access[bank];
+  }
+
+  [[nodiscard]] uint8_t ReadByte(const uint8_t addr) const noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return (*pages[GetCurrentBank()])[addr];
+  }
+
+  [[nodiscard]] uint8_t LoadByte(const uint8_t addr) noexcept {
+    if ((GetAccess(GetCurrentBank()) & BankAccess::READ) == 0) [[unlikely]] {
+      return memory.LoadByte(addr);  // Records the fault
+    }
+    return ReadByte(addr);
+  }
+
+  void WriteByte(const uint8_t addr, const uint8_t val) noexcept {
+    const uint8_t bank = GetCurrentBank();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    Memory::Bank* page = banks[bank];
+    if (page == nullptr) [[unlikely]] {
+      // Copies shared banks, checks protection and reports watched bytes
+      memory.WriteByte(addr, val);
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+      pages[bank] = memory.pages[bank];
+      banks[bank] = memory.banks[bank].get();
+      // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+      return;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    (*page)[addr] = val;
+  }
+
+  // With one bank there is nothing to switch to
+  void SetCurrentBank(const uint8_t bank) noexcept {
+    if constexpr (NumBanks > 1) {
+      curr_bank = bank;
+      memory.SetCurrentBank(bank);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "cpu.hpp"
+#include "memory.hpp"
+
+inline constexpr std::string_view CHECKPOINT_EXTENSION = ".ckpt";
+
+// Machine state between two cycles. The banks are immutable shared banks,
+// so taking a checkpoint copies no memory, and a loaded checkpoint's banks
+// view its file mapping until the resumed run writes to them.
+//
+// Serialized layout, big-endian like the rest of the toolchain:
+//   "DLWC" version:u8 cycle:u64
+//   registers:4*u8 ir:u16 pc:u8 psw:u8 halted:u8
+//   current_bank:u8 bank_count:u8
+//   present:u8 per bank, then the 256 bytes of every present bank
+// Banks of zeros are not stored.
+struct Checkpoint {
+  static constexpr std::array<uint8_t, 4> MAGIC{'D', 'L', 'W', 'C'};
+  static constexpr uint8_t VERSION = 1;
+
+  uint64_t cycle = 0;  // Cycles executed before the checkpoint
+  Cpu cpu;
+  uint8_t current_bank = 0;
+  Memory::SharedBanks banks;
+
+  [[nodiscard]] std::size_t SerializedSize() const noexcept;
+  // Writes the checkpoint into a buffer of exactly SerializedSize() bytes
+  void Serialize(std::span<uint8_t> bytes) const;
+  // Replaces `path` atomically: writes a temporary file next to it, waits
+  // for the data to reach the disk, renames it over `path` and syncs the
+  // directory. A failed write removes the temporary file.
+  void Save(const std::string& path) const;
+  [[nodiscard]] static Checkpoint Load(const std::string& path);
+};
+
+// The most recent checkpoints, up to a fixed number, for time travel. Every
+// checkpoint shares its banks with the next, so a bank costs memory again
+// only when written between two of them: at most capacity * banks * 256
+// bytes in all.
+class CheckpointRing {
+ private:
+  std::vector<Checkpoint> checkpoints;  // Oldest first once full
+  std::size_t next = 0;                 // Slot the next checkpoint replaces
+  std::size_t capacity;
+
+ public:
+  explicit CheckpointRing(std::size_t capacity);
+
+  // Replaces the oldest checkpoint once full. Checkpoints must be pushed in
+  // cycle order; one not newer than the newest held is dropped, since
+  // replaying an earlier stretch recreates the same states.
+  void Push(Checkpoint checkpoint);
+  // Newest checkpoint taken at or before `cycle`, if not yet replaced
+  [[nodiscard]] const Checkpoint* Find(uint64_t cycle) const noexcept;
+  [[nodiscard]] const Checkpoint* Oldest() const noexcept;
+  [[nodiscard]] const Checkpoint* Newest() const noexcept;
+};
+
+// Saves checkpoints on a background thread, so the emulation loop only pays
+// for taking them. A checkpoint submitted while another is being written
+// replaces any still waiting, since only the latest one matters.
+class CheckpointWriter {
+ private:
+  std::string path;
+  std::mutex mutex;
+  std::condition_variable_any submitted;
+  std::optional<Checkpoint> pending;
+  std::jthread thread;  // Last, so it starts after the other members
+
+  void Work(const std::stop_token& stop);
+
+ public:
+  explicit CheckpointWriter(std::string path);
+  // Writes the checkpoint still waiting, if any, before returning
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+  CheckpointWriter(CheckpointWriter&&) = delete;
+  CheckpointWriter& operator=(CheckpointWriter&&) = delete;
+
+  void Submit(Checkpoint checkpoint);
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef COMPILE_TIME_HPP
+#define COMPILE_TIME_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "config.hpp"
+#include "cpu.hpp"
+#include "memory.hpp"
+
+// Running programs in constant expressions, e.g. to check a program's result
+// with a static_assert or to embed precomputed results:
+//
+//   static_assert(RunProgram(image, 1000).cpu.GetRegister(RegisterId::A) == 0);
+//
+// The emulator proper keeps its banks behind shared pointers and logs as it
+// goes, neither of which constant expressions allow. RunProgram runs the
+// same Cpu against an ArrayMemory instead, without logging, protection,
+// profiling or checkpoints, and stops after a cycle budget, since constant
+// evaluation cannot wait out a program that never halts.
+
+// Memory whose banks are held in place, for constant expressions. Every bank
+// allows every access.
+template <uint8_t NumBanks = 1>
+class ArrayMemory {
+  static_assert(NumBanks > 0);
+
+ private:
+  std::array<Memory::Bank, NumBanks> banks{};
+  uint8_t curr_bank = 0;
+
+ public:
+  constexpr ArrayMemory() = default;
+  // Copies a flat image, bank << 8 | in-bank address, starting at bank 0
+  constexpr explicit ArrayMemory(const std::span<const uint8_t> image) {
+    if (image.size() > std::size_t{NumBanks} * BANK_SIZE) {
+      throw std::runtime_error(
+          "Program too large: exceeds available memory banks");
+    }
+    for (std::size_t i = 0; i < image.size(); ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      banks[i / BANK_SIZE][i % BANK_SIZE] = image[i];
+    }
+  }
+
+  [[nodiscard]] constexpr uint8_t GetCurrentBank() const noexcept {
+    return curr_bank;
+  }
+  [[nodiscard]] constexpr uint8_t GetAccess(
+      const uint8_t /*bank*/) const noexcept {
+    return BankAccess::ALL;
+  }
+  [[nodiscard]] constexpr uint8_t ReadByte(const uint8_t addr) const noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return banks[curr_bank][addr];
+  }
+  [[nodiscard]] constexpr uint8_t ReadByte(const uint8_t bank,
+                                           const uint8_t addr) const noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return banks[bank][addr];
+  }
+  [[nodiscard]] constexpr uint8_t LoadByte(const uint8_t addr) noexcept {
+    return ReadByte(addr);
+  }
+  constexpr void WriteByte(const uint8_t addr, const uint8_t val) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    banks[curr_bank][addr] = val;
+  }
+  // With one bank there is nothing to switch to, as in BankedMemory
+  constexpr void SetCurrentBank(const uint8_t bank) noexcept {
+    if constexpr (NumBanks > 1) {
+      curr_bank = bank;
+    }
+  }
+};
+
+// State of a program that ran to its halt
+template <uint8_t NumBanks>
+struct ProgramRun {
+  Cpu cpu;
+  ArrayMemory<NumBanks> memory;
+  uint64_t cycles = 0;
+};
+
+// Runs a flat image from bank 0 address 0 until it halts, cycle for cycle
+// like Emulator::Run. Throws, which fails a constant expression, if the
+// program runs more than `max_cycles` cycles.
+template <uint8_t NumBanks = 1>
+[[nodiscard]] constexpr ProgramRun<NumBanks> RunProgram(
+    const std::span<const uint8_t> image, const uint64_t max_cycles) {
+  ProgramRun<NumBanks> run{Cpu{}, ArrayMemory<NumBanks>{image}};
+  while (!run.cpu.GetHalted()) {
+    if (run.cycles == max_cycles) {
+      throw std::runtime_error("Program did not halt within " +
+                               std::to_string(max_cycles) + " cycles");
+    }
+    ++run.cycles;
+    run.cpu.Fetch(run.memory);
+    run.cpu.Execute(run.cpu.Decode(), run.memory);
+  }
+  return run;
+}
+
+#endif
@@ -1,21 +1,62 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <vector>
+
+// Accesses a memory bank allows, as bit flags
+struct BankAccess {
+  static constexpr uint8_t NONE = 0b000;
+  static constexpr uint8_t READ = 0b001;
+  static constexpr uint8_t WRITE = 0b010;
+  static constexpr uint8_t EXECUTE = 0b100;
+  static constexpr uint8_t ALL = READ | WRITE | EXECUTE;
+};
+
+// Accesses one bank allows; banks without one allow all accesses
+struct BankProtection {
+  uint8_t bank;
+  uint8_t access;  // BankAccess flags
+};
+
+// Byte of one bank, as given on the command line
+struct BankAddress {
+  uint8_t bank;
+  uint8_t addr;
+};
 
 struct Config {
   static constexpr uint8_t DEFAULT_NUM_BANKS = 1;
   static constexpr uint8_t MIN_BANKS = 1;
   static constexpr uint8_t MAX_BANKS = 255;
+  static constexpr uint64_t DEFAULT_SNAPSHOT_INTERVAL = 1000;
+  static constexpr std::size_t DEFAULT_SNAPSHOT_COUNT = 64;
 
   uint8_t num_banks;
   std::string program_file_path;
+  std::string symbol_file_path;  // Optional symbol map from the assembler
+  std::vector<BankProtection> protections;
+  uint64_t checkpoint_interval = 0;  // Cycles between checkpoints, 0 for none
+  std::string checkpoint_file_path;
+  std::string resume_file_path;  // Optional checkpoint to resume from
+  // Time travel: cycles between snapshots kept in memory, 0 for none
+  uint64_t snapshot_interval = 0;
+  std::size_t snapshot_count = DEFAULT_SNAPSHOT_COUNT;
+  // Where to travel after the run halts
+  std::optional<uint64_t> goto_cycle;
+  std::optional<BankAddress> back_to_write;
 
   void Validate() const;
-
- private:
-  static void ValidateProgramFile(const std::string& file_path);
+  // Whether the program is assembly source to assemble in memory
+  [[nodiscard]] bool ProgramIsSource() const;
+  // Parses "BANK:FLAGS", where FLAGS combines r, w and x, e.g. "0:rx" for
+  // a read-only code bank, or is "-" for no access
+  [[nodiscard]] static BankProtection ParseProtection(const std::string& text);
+  // Parses "BANK:ADDR", where ADDR is decimal or 0x-prefixed hexadecimal
+  [[nodiscard]] static BankAddress ParseAddress(const std::string& text);
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define CPU_HPP
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include "instruction.hpp"
@@ -13,32 +14,476 @@ class Cpu {
   bool halted;
   uint16_t ir;      // 16-bit (2 byte) instruction register
   uint8_t pc;       // 8-bit (1 byte) program counter
-  uint8_t psw : 2;  // 2-bit processor status word
+  // Result of the last add or sub. The 2-bit processor status word is
+  // derived from it only when read, so arithmetic never computes flags.
+  uint8_t flags_result;
 
-  [[nodiscard]] uint8_t ReadRegister(const RegisterId id) const noexcept;
-  void UpdateProcessorStatusWord(const uint8_t result) noexcept;
-  void WriteRegister(const RegisterId id, const uint8_t value) noexcept;
+  // DecodeFields() of every encoding, generated at compile time
+  static const std::array<DecodedInstruction, NUM_ENCODINGS> DECODE_TABLE;
+
+  [[nodiscard]] constexpr uint8_t ReadRegister(
+      const RegisterId id) const noexcept;
+  // A result whose status word is `psw`: 0b01 zero, 0b10 negative, 0b00
+  // neither
+  [[nodiscard]] static constexpr uint8_t ResultWithPsw(uint8_t psw) noexcept;
+  constexpr void WriteRegister(const RegisterId id,
+                               const uint8_t value) noexcept;
+  // Parts of ExecuteFused(). Execute() spells the same steps out in its
+  // cases, which keeps it a single body compilers inline whole.
+  // Runs an add or sub and returns its result
+  constexpr uint8_t ExecuteAlu(const Instruction& ins) noexcept;
+  // Address a load other than a bank switch reads
+  [[nodiscard]] constexpr uint8_t LoadAddress(
+      const Instruction& ins) const noexcept;
+  // Address a jump other than halt goes to, once fetched
+  [[nodiscard]] constexpr uint8_t JumpTarget(
+      const Instruction& ins) const noexcept;
 
  public:
-  Cpu() : gpr{}, ir{0}, pc{0}, psw{0}, halted{false} {}
-  // State constructor for unit testing
-  Cpu(std::array<uint8_t, 4> gpr, uint16_t ir, uint8_t pc, uint8_t psw,
-      bool halted)
-      : gpr{gpr}, ir{ir}, pc{pc}, psw{psw}, halted{halted} {}
-
-  [[nodiscard]] Instruction Decode() const noexcept;
-  void Execute(const Instruction& ins, Memory& memory) noexcept;
-  void Fetch(const Memory& memory) noexcept;
-  bool GetHalted() const noexcept;
-  [[nodiscard]] uint16_t GetIr() const noexcept;
-  [[nodiscard]] uint8_t GetPc() const noexcept;
-  [[nodiscard]] uint8_t GetPsw() const noexcept;
-  [[nodiscard]] uint8_t GetRegister(RegisterId id) const noexcept;
-
-  [[nodiscard]] static int16_t CalculateOffset(uint16_t imm,
-                                               Opcode opcode) noexcept;
+  constexpr Cpu()
+      : gpr{}, ir{0}, pc{0}, flags_result{ResultWithPsw(0)}, halted{false} {}
+  // State constructor for unit testing and restoring checkpoints. `psw` is
+  // one the CPU sets: 0b00, 0b01 or 0b10.
+  constexpr Cpu(std::array<uint8_t, 4> gpr, uint16_t ir, uint8_t pc,
+                uint8_t psw, bool halted)
+      : gpr{gpr},
+        ir{ir},
+        pc{pc},
+        flags_result{ResultWithPsw(psw)},
+        halted{halted} {}
+
+  // Decodes the instruction register with a single table lookup, or field
+  // by field in constant expressions, which cannot read the table
+  [[nodiscard]] constexpr Instruction Decode() const noexcept;
+  // Decodes any encoding the same way
+  [[nodiscard]] static constexpr Instruction Decode(uint16_t ir) noexcept;
+  // Decodes an encoding field by field; the reference the decode table is
+  // generated from
+  [[nodiscard]] static constexpr Instruction DecodeFields(uint16_t ir) noexcept;
+  // `memory` is a Memory, a BankedMemory specialized for its bank count, an
+  // ObservedMemory reporting the accesses to execution observers, or an
+  // ArrayMemory in constant expressions
+  template <typename MemoryBus>
+  constexpr void Execute(const Instruction& ins, MemoryBus& memory) noexcept;
+  // Macro-op fusion: if `ins`, just fetched, is an add or sub followed by a
+  // conditional jump, or a load followed by an add or sub, fetches the next
+  // instruction and runs both as one, leaving the state Execute(), Fetch()
+  // and Execute() would. The jump tests the add or sub result while it is
+  // still at hand. Returns false, having run nothing, for any other
+  // instruction.
+  template <typename MemoryBus>
+  constexpr bool ExecuteFused(const Instruction& ins,
+                              MemoryBus& memory) noexcept;
+  template <typename MemoryBus>
+  constexpr void Fetch(const MemoryBus& memory) noexcept;
+  [[nodiscard]] constexpr bool GetHalted() const noexcept;
+  [[nodiscard]] constexpr uint16_t GetIr() const noexcept;
+  [[nodiscard]] constexpr uint8_t GetPc() const noexcept;
+  [[nodiscard]] constexpr uint8_t GetPsw() const noexcept;
+  [[nodiscard]] constexpr uint8_t GetRegister(RegisterId id) const noexcept;
+
+  [[nodiscard]] static constexpr int16_t CalculateOffset(
+      uint16_t imm, Opcode opcode) noexcept;
 };
 
 std::ostream& operator<<(std::ostream& os, const Cpu& cpu);
 
+// Decode, Fetch, Execute and the helpers they call are defined here, so every
+// memory type they are instantiated for compiles to one inlined interpreter
+// step, and so they run in constant expressions
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,hicpp-signed-bitwise,readability-magic-numbers)
+
+constexpr bool Cpu::GetHalted() const noexcept { return halted; }
+
+constexpr uint16_t Cpu::GetIr() const noexcept { return ir; }
+
+constexpr uint8_t Cpu::GetPc() const noexcept { return pc; }
+
+constexpr uint8_t Cpu::GetPsw() const noexcept {
+  if (flags_result == 0) {
+    return 0b01;
+  }
+  if (static_cast<int8_t>(flags_result) < 0) {
+    return 0b10;
+  }
+  return 0b00;
+}
+
+constexpr uint8_t Cpu::GetRegister(const RegisterId id) const noexcept {
+  return ReadRegister(id);
+}
+
+constexpr uint8_t Cpu::ReadRegister(const RegisterId id) const noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  return gpr[static_cast<std::size_t>(id)];
+}
+
+constexpr uint8_t Cpu::ResultWithPsw(const uint8_t psw) noexcept {
+  switch (psw & 0b11U) {
+    case 0b01:
+      return 0;
+    case 0b10:
+      return 0x80;
+    default:
+      return 1;
+  }
+}
+
+constexpr void Cpu::WriteRegister(const RegisterId id,
+                                  const uint8_t value) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  gpr[static_cast<std::size_t>(id)] = value;
+}
+
+constexpr int16_t Cpu::CalculateOffset(uint16_t imm,
+                                       Opcode opcode) noexcept {
+  if (opcode == Opcode::LOAD || opcode == Opcode::STORE) {
+    // Process as an 8-bit immediate
+    return static_cast<int16_t>(static_cast<int8_t>(imm));
+  } else {
+    // Process as a 9-bit immediate
+    imm &= 0x1FFU;
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    imm = (imm & 0x100U) ? (imm | ~0x1FFU) : imm;  // Sign extend to 16 bits
+    return static_cast<int16_t>(imm);
+  }
+}
+
+constexpr Instruction Cpu::DecodeFields(const uint16_t ir) noexcept {
+  Instruction ins{};
+
+  ins.raw = ir;
+
+  // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+  const bool mode_bit = ir & 0b1U;
+
+  const uint8_t opcode_bits = (ir >> 1U) & 0b111U;
+  ins.opcode = static_cast<Opcode>(opcode_bits);
+
+  switch (ins.opcode) {
+    case Opcode::ADD:
+    case Opcode::SUB:
+      if (mode_bit) {
+        ins.mode = AddressingMode::IMMEDIATE;
+        ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+        ins.dest = static_cast<RegisterId>((ir >> 6U) & 0b11U);
+        ins.imm = (ir >> 8U) & 0xFFU;
+      } else {
+        ins.mode = AddressingMode::REGISTER;
+        ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+        ins.src2 = static_cast<RegisterId>((ir >> 6U) & 0b11U);
+        ins.dest = static_cast<RegisterId>((ir >> 8U) & 0b11U);
+      }
+      break;
+    case Opcode::LOAD:
+      if (mode_bit) {
+        if (((ir >> 4U) & 0b11U) == 0) {
+          ins.mode = AddressingMode::IMMEDIATE;
+          ins.dest = static_cast<RegisterId>((ir >> 6U) & 0b11U);
+          ins.imm = (ir >> 8U) & 0xFFU;
+        } else {
+          ins.mode = AddressingMode::RELATIVE;
+          ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+          ins.dest = static_cast<RegisterId>((ir >> 6U) & 0b11U);
+          ins.imm = (ir >> 8U) & 0xFFU;
+        }
+      } else {
+        if (((ir >> 6U) & 0b11U) == 0) {
+          ins.mode = AddressingMode::REGISTER;
+          ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+          ins.dest = static_cast<RegisterId>((ir >> 8U) & 0b11U);
+        } else {
+          ins.imm = (ir >> 8U) & 0xFFU;  // Bank switch
+        }
+      }
+      break;
+    case Opcode::STORE:
+      if (mode_bit) {
+        if (((ir >> 4U) & 0b11U) == 0) {
+          ins.mode = AddressingMode::IMMEDIATE;
+          ins.src = static_cast<RegisterId>((ir >> 6U) & 0b11U);
+          ins.imm = (ir >> 8U) & 0xFFU;
+        } else {
+          ins.mode = AddressingMode::RELATIVE;
+          ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+          ins.src2 = static_cast<RegisterId>((ir >> 6U) & 0b11U);
+          ins.imm = (ir >> 8U) & 0xFFU;
+        }
+      } else {
+        if (((ir >> 6U) & 0b11U) == 0) {
+          ins.mode = AddressingMode::REGISTER;
+          ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+          ins.dest = static_cast<RegisterId>((ir >> 8U) & 0b11U);
+        } else {
+          ins.mode = AddressingMode::NONE;
+          ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+          ins.dest = static_cast<RegisterId>((ir >> 8U) & 0b11U);
+        }
+      }
+      break;
+    case Opcode::JUMP:
+    case Opcode::JUMPZ:
+    case Opcode::JUMPNZ:
+    case Opcode::JUMPN:
+      if (mode_bit) {
+        if (((ir >> 4U) & 0b11U) == 0) {
+          ins.mode = AddressingMode::IMMEDIATE;
+          ins.imm = (ir >> 8U) & 0xFFU;
+        } else {
+          ins.mode = AddressingMode::RELATIVE;
+          ins.imm =
+              (ir >> 7U) & 0x1FFU;  // Using 9-bit immedaite for relative jumps
+        }
+      } else {
+        if ((ir >> 6U) == 0) {
+          ins.mode = AddressingMode::REGISTER;
+          ins.src = static_cast<RegisterId>((ir >> 4U) & 0b11U);
+        } else {
+          break;  // Halt
+        }
+      }
+      break;
+  }
+  return ins;
+}
+
+constexpr Instruction Cpu::Decode() const noexcept {
+  if consteval {
+    return DecodeFields(ir);
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  const DecodedInstruction& decoded = DECODE_TABLE[ir];
+  return {decoded.mode, decoded.opcode, decoded.src,
+          decoded.src2, decoded.dest, decoded.imm, ir};
+}
+
+constexpr Instruction Cpu::Decode(const uint16_t ir) noexcept {
+  if consteval {
+    return DecodeFields(ir);
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  const DecodedInstruction& decoded = DECODE_TABLE[ir];
+  return {decoded.mode, decoded.opcode, decoded.src,
+          decoded.src2, decoded.dest, decoded.imm, ir};
+}
+
+constexpr uint8_t Cpu::ExecuteAlu(const Instruction& ins) noexcept {
+  const uint8_t x = ReadRegister(ins.src);
+
+  const uint8_t y = (ins.mode == AddressingMode::IMMEDIATE)
+                        ? ins.imm
+                        : ReadRegister(ins.src2);
+
+  const uint8_t result = (ins.opcode == Opcode::ADD) ? x + y : x - y;
+
+  WriteRegister(ins.dest, result);
+  flags_result = result;
+  return result;
+}
+
+constexpr uint8_t Cpu::LoadAddress(const Instruction& ins) const noexcept {
+  switch (ins.mode) {
+    case AddressingMode::IMMEDIATE:
+      return ins.imm;
+    case AddressingMode::REGISTER:
+      return ReadRegister(ins.src);
+    default:
+      return ReadRegister(ins.src) + CalculateOffset(ins.imm, ins.opcode);
+  }
+}
+
+constexpr uint8_t Cpu::JumpTarget(const Instruction& ins) const noexcept {
+  switch (ins.mode) {
+    case AddressingMode::IMMEDIATE:
+      return ins.imm;
+    case AddressingMode::REGISTER:
+      return ReadRegister(ins.src);
+    default:
+      return pc + CalculateOffset(ins.imm, ins.opcode);
+  }
+}
+
+template <typename MemoryBus>
+constexpr void Cpu::Fetch(const MemoryBus& memory) noexcept {
+  if (pc > 254) {
+    halted = true;
+    return;
+  }
+
+  const uint8_t high = memory.ReadByte(pc++);
+  const uint8_t low = memory.ReadByte(pc++);
+  ir = (high << 8U) | low;
+}
+
+template <typename MemoryBus>
+constexpr void Cpu::Execute(const Instruction& ins, MemoryBus& memory) noexcept {
+  switch (ins.opcode) {
+    case Opcode::ADD:
+    case Opcode::SUB: {
+      const uint8_t x = ReadRegister(ins.src);
+
+      const uint8_t y = (ins.mode == AddressingMode::IMMEDIATE)
+                            ? ins.imm
+                            : ReadRegister(ins.src2);
+
+      const uint8_t result = (ins.opcode == Opcode::ADD) ? x + y : x - y;
+
+      WriteRegister(ins.dest, result);
+      flags_result = result;
+      break;
+    }
+    case Opcode::LOAD:
+      switch (ins.mode) {
+        case AddressingMode::IMMEDIATE:
+          WriteRegister(ins.dest, memory.LoadByte(ins.imm));
+          break;
+        case AddressingMode::REGISTER:
+          WriteRegister(ins.dest, memory.LoadByte(ReadRegister(ins.src)));
+          break;
+        case AddressingMode::RELATIVE: {
+          const uint8_t addr =
+              ReadRegister(ins.src) + CalculateOffset(ins.imm, ins.opcode);
+          WriteRegister(ins.dest, memory.LoadByte(addr));
+          break;
+        }
+        case AddressingMode::NONE:
+          memory.SetCurrentBank(ins.imm);
+        default:
+          break;
+      }
+      break;
+    case Opcode::STORE:
+      switch (ins.mode) {
+        case AddressingMode::IMMEDIATE:
+          memory.WriteByte(ins.imm, ReadRegister(ins.src));
+          break;
+        case AddressingMode::REGISTER:
+          memory.WriteByte(ReadRegister(ins.dest), ReadRegister(ins.src));
+          break;
+        case AddressingMode::RELATIVE: {
+          const uint8_t addr =
+              ReadRegister(ins.src) + CalculateOffset(ins.imm, ins.opcode);
+          memory.WriteByte(addr, ReadRegister(ins.src2));
+          break;
+        }
+        case AddressingMode::NONE:
+          WriteRegister(ins.dest, ReadRegister(ins.src));
+          break;
+        default:
+          break;
+      }
+      break;
+    case Opcode::JUMP:
+    case Opcode::JUMPZ:
+    case Opcode::JUMPNZ:
+    case Opcode::JUMPN: {
+      uint8_t addr{};
+
+      switch (ins.mode) {
+        case AddressingMode::IMMEDIATE:
+          addr = ins.imm;
+          break;
+        case AddressingMode::REGISTER:
+          addr = ReadRegister(ins.src);
+          break;
+        case AddressingMode::RELATIVE: {
+          addr = pc + CalculateOffset(ins.imm, ins.opcode);
+          break;
+        }
+        case AddressingMode::NONE:
+          halted = true;
+          return;
+        default:
+          break;
+      }
+
+      bool execute_jump = false;
+      switch (ins.opcode) {
+        case Opcode::JUMP:
+          execute_jump = true;
+          break;
+        case Opcode::JUMPZ:
+          execute_jump = flags_result == 0;
+          break;
+        case Opcode::JUMPNZ:
+          execute_jump = static_cast<int8_t>(flags_result) > 0;
+          break;
+        case Opcode::JUMPN:
+          execute_jump = static_cast<int8_t>(flags_result) < 0;
+          break;
+        default:
+          break;
+      }
+
+      if (execute_jump) {
+        pc = addr;
+      }
+
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+template <typename MemoryBus>
+constexpr bool Cpu::ExecuteFused(const Instruction& ins,
+                                 MemoryBus& memory) noexcept {
+  const bool alu = ins.opcode == Opcode::ADD || ins.opcode == Opcode::SUB;
+  const bool load =
+      ins.opcode == Opcode::LOAD && ins.mode != AddressingMode::NONE;
+  // Past address 254 the next fetch halts instead
+  if ((!alu && !load) || pc > 254) {
+    return false;
+  }
+
+  // Neither an add or sub nor a load changes memory, so the next instruction
+  // can be read before the first runs
+  const auto next_ir = static_cast<uint16_t>(
+      (memory.ReadByte(pc) << 8U) |
+      memory.ReadByte(static_cast<uint8_t>(pc + 1)));
+  const Instruction next = Decode(next_ir);
+
+  if (load) {
+    if (next.opcode != Opcode::ADD && next.opcode != Opcode::SUB) {
+      return false;
+    }
+    WriteRegister(ins.dest, memory.LoadByte(LoadAddress(ins)));
+  } else {
+    const bool branch = next.opcode == Opcode::JUMPZ ||
+                        next.opcode == Opcode::JUMPNZ ||
+                        next.opcode == Opcode::JUMPN;
+    if (!branch || next.mode == AddressingMode::NONE) {
+      return false;
+    }
+  }
+
+  const uint8_t result = ExecuteAlu(load ? next : ins);
+  ir = next_ir;
+  pc += 2;
+  if (load) {
+    return true;
+  }
+
+  bool execute_jump = false;
+  switch (next.opcode) {
+    case Opcode::JUMPZ:
+      execute_jump = result == 0;
+      break;
+    case Opcode::JUMPNZ:
+      execute_jump = static_cast<int8_t>(result) > 0;
+      break;
+    default:
+      execute_jump = static_cast<int8_t>(result) < 0;
+      break;
+  }
+  if (execute_jump) {
+    pc = JumpTarget(next);
+  }
+  return true;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,hicpp-signed-bitwise,readability-magic-numbers)
+
 #endif
@@ -0,0 +1,52 @@
+#ifndef DEBUGGER_HPP
+#define DEBUGGER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "emulator.hpp"
+
+// Interactive debugger driving an emulator from a command line REPL.
+//
+// Breakpoints are a bitmap per bank that is only consulted on entering a
+// block, i.e. after a jump, bank switch or address wrap: the next breakpoint
+// of the block is found with a scan of the bank's four bitmap words, and the
+// instructions up to it run with one address compare each. Watchpoints are
+// left to Memory, where only banks with a watched byte leave the write fast
+// path. A plain Run() checks neither.
+class Debugger {
+ private:
+  static constexpr std::size_t BITMAP_WORDS = BANK_SIZE / 64;
+  using Bitmap = std::array<uint64_t, BITMAP_WORDS>;
+
+  Emulator& emulator;
+  std::vector<Bitmap> breakpoints;  // Per bank
+
+  // First breakpoint at or after `from` in the bank, or BANK_SIZE if none
+  [[nodiscard]] std::size_t NextBreakpoint(uint8_t bank,
+                                           std::size_t from) const noexcept;
+  void SetBreakpoint(uint8_t bank, uint8_t addr, bool enabled);
+  // Run until a breakpoint, a watched byte changes or the program halts.
+  // Steps ignore breakpoints.
+  void Continue(std::ostream& output);
+  void Step(uint64_t count, std::ostream& output);
+  // Reports a watched byte's change and clears it; false if none changed
+  bool ReportWatchHit(std::ostream& output);
+  void Dump(uint8_t bank, uint8_t addr, std::size_t count,
+            std::ostream& output) const;
+  // Runs one command line; false once the session should end
+  bool Execute(const std::string& line, std::ostream& output);
+
+ public:
+  // The emulator must have its program loaded
+  explicit Debugger(Emulator& emulator);
+
+  // Reads commands from `input` until quit or the end of the input
+  void Repl(std::istream& input, std::ostream& output);
+};
+
+#endif
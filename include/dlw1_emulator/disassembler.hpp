@@ -0,0 +1,29 @@
+#ifndef DISASSEMBLER_HPP
+#define DISASSEMBLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Turns instruction register values back into assembly text the assembler
+// accepts, e.g. 0x0042 -> "sub ra, rb, ra". Bit patterns the CPU decodes the
+// same way disassemble to the same canonical text.
+//
+// The low byte of an instruction selects its mnemonic, addressing mode and
+// registers, so a compile-time table maps it to the text around the operand
+// the high byte holds; the operand itself comes from another small table.
+// Disassembling is two lookups and a few copies into the caller's buffer.
+class Disassembler {
+ public:
+  // Buffer size Disassemble() needs; the longest text it writes, e.g.
+  // "store rd, (rd - #128)", is shorter
+  static constexpr std::size_t MAX_TEXT_SIZE = 32;
+
+  // Writes the text into `buffer`, without allocating, and returns a view
+  // of it
+  [[nodiscard]] static std::string_view Disassemble(
+      uint16_t ir, std::span<char, MAX_TEXT_SIZE> buffer) noexcept;
+};
+
+#endif
@@ -1,24 +1,106 @@
 #ifndef EMULATOR_HPP
 #define EMULATOR_HPP
 
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
+#include "checkpoint.hpp"
 #include "config.hpp"
 #include "cpu.hpp"
+#include "dlw1_assembler/program_image.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
 #include "memory.hpp"
 
 class Emulator {
+  friend class Debugger;
+
  private:
   Cpu cpu;
   Memory memory;
   Config config;
+  std::optional<SymbolMap> symbols;
+  std::vector<uint64_t> profile;  // Instructions fetched per image address
+  uint64_t cycle_count = 0;
+  std::optional<CheckpointRing> snapshots;  // Time travel, when enabled
+
+  // Copies a flat image into the banks, starting at bank 0
+  void LoadImage(std::span<const uint8_t> image);
+  // Places each segment at its address, write-protects read-only segments'
+  // banks and starts execution at the entry point. Rejects images where a
+  // read-only segment shares a bank with a writable one.
+  void LoadSegments(const ProgramImage& image);
+  void ReadProgram();
+  // Assembles a source program in memory, with no intermediate image file
+  void AssembleProgram();
+  void LoadSymbols();
+  void ProtectBanks();
+  // Replaces the loaded state with the checkpoint's, keeping the banks'
+  // protection
+  void Resume();
+  // Replaces the machine state with the checkpoint's, keeping the banks'
+  // protection and watchpoints
+  void Restore(const Checkpoint& checkpoint);
+  // Whether a snapshot or checkpoint is taken after `cycle`
+  [[nodiscard]] bool RecordsState(uint64_t cycle) const noexcept;
+  // Runs one cycle against `bus`, the memory or a BankedMemory view of it,
+  // reporting it to the observers, and returns the flat address of its
+  // instruction. Observed cycles run against the memory itself. With Fuse,
+  // an unobserved instruction that Cpu::ExecuteFused() pairs with the next
+  // one runs the next cycle too, unless state is recorded in between; the
+  // second instruction is profiled here.
+  template <bool Fuse = false, typename MemoryBus, typename... Observers>
+  uint16_t Step(MemoryBus& bus, Observers&... observers);
+  // Runs until the program halts, profiling and checkpointing, and returns
+  // the halt address. Unobserved runs fuse instruction pairs.
+  template <typename MemoryBus, typename... Observers>
+  uint16_t RunLoop(MemoryBus& bus,
+                   std::optional<CheckpointWriter>& checkpoints,
+                   Observers&... observers);
+  // Replays cycles from the current state until cycle `target`
+  void Replay(uint64_t target);
+  // Logs the initial state and takes the first snapshot, before the first
+  // cycle
+  void Start();
+  // Throws the error for an access denied to the instruction at `address`
+  [[noreturn]] void Fault(const MemoryFault& fault, uint16_t address,
+                          uint16_t ir) const;
+  // Resolves the halt address and hottest instructions against the symbol
+  // map in one batch, after the run
+  void Report(uint16_t halt_address) const;
 
  public:
   explicit Emulator(const Config& config)
       : config{config}, memory{config.num_banks} {}
 
   void LoadProgram();
+  // Starts from the banks of a program another emulator loaded and shared.
+  // Only banks this emulator writes get copied, so any number of emulators
+  // running one program hold a single copy of its code.
+  void LoadProgram(const Memory::SharedBanks& program);
+  // Shares the loaded program's banks; call before Run()
+  [[nodiscard]] Memory::SharedBanks ShareProgram();
+  // Runs the program to its end. A NumBanks other than 0 runs a loop
+  // specialized for that bank count, which must be the configured one; only
+  // the counts 1, 2, 4 and 8 are instantiated.
+  template <uint8_t NumBanks = 0>
   void Run();
+
+  // Time travel, once Run() has started with a snapshot interval. Each call
+  // restores the newest snapshot before the target and replays from there,
+  // which is deterministic since programs take no input.
+  void GotoCycle(uint64_t cycle);
+  void StepBack();
+  // Goes back to just before the last instruction that changed the byte, and
+  // returns its cycle, or stays put if no snapshot still held reaches it
+  std::optional<uint64_t> RunBackToWrite(uint8_t bank, uint8_t addr);
+
+  [[nodiscard]] uint64_t GetCycle() const noexcept;
+  [[nodiscard]] const Cpu& GetCpu() const noexcept;
+  // Cycle count and the next instruction's source location or disassembly
+  [[nodiscard]] std::string DescribePosition() const;
 };
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef FORMATTERS_HPP
+#define FORMATTERS_HPP
+
+#include "cpu.hpp"
+#include "instruction.hpp"
+#include "memory.hpp"
+#include "spdlog/fmt/fmt.h"
+
+// fmt formatters that render the same text as the operator<< overloads,
+// written straight into the format buffer. Logging `cpu` instead of
+// `to_string(cpu)` skips the stream and the copy, and spdlog only formats
+// messages for enabled levels.
+
+template <>
+struct fmt::formatter<Cpu> {
+  constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+  fmt::format_context::iterator format(const Cpu& cpu,
+                                       fmt::format_context& ctx) const;
+};
+
+template <>
+struct fmt::formatter<Instruction> {
+  constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+  fmt::format_context::iterator format(const Instruction& ins,
+                                       fmt::format_context& ctx) const;
+};
+
+template <>
+struct fmt::formatter<Memory> {
+  constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+  fmt::format_context::iterator format(const Memory& memory,
+                                       fmt::format_context& ctx) const;
+};
+
+// "bank B address 0xAA: 0xOO -> 0xNN"
+template <>
+struct fmt::formatter<MemoryWrite> {
+  constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+  fmt::format_context::iterator format(const MemoryWrite& write,
+                                       fmt::format_context& ctx) const;
+};
+
+#endif
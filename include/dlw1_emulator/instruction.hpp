@@ -1,10 +1,11 @@
 #ifndef INSTRUCTION_HPP
 #define INSTRUCTION_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 
-enum class AddressingMode {
+enum class AddressingMode : uint8_t {
   IMMEDIATE,
   REGISTER,
   RELATIVE,
@@ -43,8 +44,25 @@ struct Instruction {
   uint16_t imm;
 
   uint16_t raw;
+
+  friend bool operator==(const Instruction&, const Instruction&) = default;
 };
 
+// Number of 16-bit instruction encodings
+constexpr std::size_t NUM_ENCODINGS = std::size_t{1} << 16U;
+
+// An Instruction without its encoding, as Cpu's decode table stores it
+struct DecodedInstruction {
+  AddressingMode mode;
+  Opcode opcode;
+  RegisterId src;
+  RegisterId src2;
+  RegisterId dest;
+  uint16_t imm;
+};
+
+static_assert(sizeof(DecodedInstruction) == 8);
+
 std::ostream& operator<<(std::ostream& os, const Instruction& ins);
 
 #endif
@@ -2,33 +2,132 @@
 #define MEMORY_HPP
 
 #include <array>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "config.hpp"
 
 constexpr size_t BANK_SIZE = 256;
 
+// A store to a byte, as execution observers and watchpoints report it
+struct MemoryWrite {
+  uint8_t bank;
+  uint8_t addr;
+  uint8_t old_value;
+  uint8_t new_value;
+};
+
+// An access the bank protections denied
+struct MemoryFault {
+  uint8_t bank;
+  uint8_t addr;
+  uint8_t access;  // The BankAccess flag that was missing
+};
+
+// Banks are allocated on their first write that changes a byte. Until then
+// reads of a bank are served from a zero page shared by every instance, so a
+// memory configured with many banks costs little more than the banks it uses.
+//
+// Banks can also be shared between instances, e.g. the code of a program
+// that many emulators run. Shared banks are immutable; the first write to
+// one gives the writing instance its own copy of just that bank.
+//
+// Banks can be protected against reads, writes and execution. Writes to a
+// write-protected bank take the same slow path as writes to a shared bank,
+// so protection costs the write path nothing. So do writes to a bank with a
+// watched byte, which leaves unwatched banks' writes as fast as ever.
 class Memory {
+  // Caches the bank tables for run loops specialized by bank count
+  template <uint8_t NumBanks>
+  friend class BankedMemory;
+
+ public:
+  using Bank = std::array<uint8_t, BANK_SIZE>;
+  // Immutable banks, indexed by bank number; null for banks of zeros
+  using SharedBanks = std::vector<std::shared_ptr<const Bank>>;
+
  private:
+  static constexpr Bank ZERO_PAGE{};
+
   uint8_t curr_bank;
-  std::vector<std::array<uint8_t, BANK_SIZE>> banks;
   uint8_t num_banks;
+  std::vector<const Bank*> pages;  // What reads see
+  // Banks only this instance references; null for shared and zero banks,
+  // so a write needs a single check
+  std::vector<std::unique_ptr<Bank>> banks;
+  SharedBanks shared;
+  std::vector<uint8_t> access;  // BankAccess flags per bank
+  std::optional<MemoryFault> fault;
+  // Watched bytes per bank, and whether a bank has any; empty until the
+  // first watchpoint
+  std::vector<std::bitset<BANK_SIZE>> watchpoints;
+  std::vector<uint8_t> watched;
+  std::optional<MemoryWrite> watch_hit;
+
+  Bank& MakeWritable(uint8_t bank);
+  // Writes a changed byte to a watched bank, keeping it on the slow path
+  void WriteWatched(uint8_t addr, uint8_t val);
 
  public:
-  Memory()
-      : num_banks{Config::DEFAULT_NUM_BANKS},
-        banks{Config::DEFAULT_NUM_BANKS},
-        curr_bank{0} {}
+  Memory() : Memory(Config::DEFAULT_NUM_BANKS) {}
   Memory(uint8_t num_banks)
-      : num_banks{num_banks}, banks{num_banks}, curr_bank{0} {}
+      : curr_bank{0},
+        num_banks{num_banks},
+        pages(num_banks, &ZERO_PAGE),
+        banks(num_banks),
+        shared(num_banks),
+        access(num_banks, BankAccess::ALL) {}
+  // Starts out reading `shared_banks`, which must hold 1 to 255 banks
+  explicit Memory(const SharedBanks& shared_banks);
 
   [[nodiscard]] uint8_t GetCurrentBank() const noexcept;
   [[nodiscard]] uint8_t GetNumBanks() const noexcept;
   [[nodiscard]] uint8_t ReadByte(const uint8_t addr) const noexcept;
+  // Reads from any bank without switching to it
+  [[nodiscard]] uint8_t ReadByte(uint8_t bank, uint8_t addr) const noexcept;
   void SetCurrentBank(const uint8_t bank) noexcept;
   void WriteByte(const uint8_t addr, const uint8_t val) noexcept;
+  // Copies bytes to a flat address, bank << 8 | in-bank address, a bank at a
+  // time. For program loaders: ignores protections and watchpoints, and
+  // the bytes must fit in the banks.
+  void LoadBytes(uint16_t address, std::span<const uint8_t> bytes);
+  // Reads for a load instruction, which the bank's protection can deny
+  [[nodiscard]] uint8_t LoadByte(uint8_t addr) noexcept;
+
+  // Sets the BankAccess flags of a bank; all banks start with all of them
+  void SetAccess(uint8_t bank, uint8_t flags);
+  [[nodiscard]] uint8_t GetAccess(uint8_t bank) const noexcept;
+  // First access denied since the last ClearFault(). Denied writes change
+  // nothing; denied loads read zero.
+  [[nodiscard]] const std::optional<MemoryFault>& GetFault() const noexcept;
+  void ClearFault() noexcept;
+
+  // Reports writes that change the byte, for debuggers
+  void Watch(uint8_t bank, uint8_t addr, bool enabled);
+  [[nodiscard]] bool IsWatched(uint8_t bank, uint8_t addr) const noexcept;
+  // First change to a watched byte since the last ClearWatchHit()
+  [[nodiscard]] const std::optional<MemoryWrite>& GetWatchHit() const noexcept;
+  void ClearWatchHit() noexcept;
+
+  // Replaces the contents of every bank with `shared_banks`, which must hold
+  // as many banks, keeping protections and watchpoints. Clears any fault.
+  void Restore(const SharedBanks& shared_banks);
+
+  // Freezes every bank this instance owns into an immutable shared bank and
+  // returns all banks, for other instances to start from. Later writes by
+  // this instance copy the affected bank like any other sharer's.
+  [[nodiscard]] SharedBanks Share();
+
+  // Banks only this instance references, and the bytes they and the bank
+  // tables occupy. Shared banks are not counted.
+  [[nodiscard]] std::size_t GetAllocatedBanks() const noexcept;
+  [[nodiscard]] std::size_t GetAllocatedBytes() const noexcept;
 
   friend std::ostream& operator<<(std::ostream& os, const Memory& mem);
 };
@@ -0,0 +1,83 @@
+#ifndef OBSERVERS_HPP
+#define OBSERVERS_HPP
+
+#include <cstdint>
+#include <tuple>
+
+#include "cpu.hpp"
+#include "instruction.hpp"
+#include "memory.hpp"
+
+// Execution observers see each instruction the emulator retires and each
+// memory access it makes. The run loop is instantiated per set of observers,
+// so hooks are direct calls the compiler can inline, and the loop for the
+// empty set is the plain interpreter with no checks at all.
+//
+// Observers derive from ExecutionObserver and hide the hooks they use. Hooks
+// run inside Cpu::Execute, which is noexcept, so they must not throw.
+struct ExecutionObserver {
+  // After an instruction executed without a memory fault
+  void OnRetire(const Instruction& /*ins*/, const Cpu& /*cpu*/) noexcept {}
+  // A load instruction read `value`; zero if the bank denied the read
+  void OnMemRead(uint8_t /*bank*/, uint8_t /*addr*/,
+                 uint8_t /*value*/) noexcept {}
+  // A store instruction wrote a byte. The values are equal if the byte did
+  // not change, e.g. because the bank denied the write.
+  void OnMemWrite(const MemoryWrite& /*write*/) noexcept {}
+  void OnBankSwitch(uint8_t /*from*/, uint8_t /*to*/) noexcept {}
+};
+
+// The memory an observed instruction executes against: forwards each access
+// to the memory and reports it to every observer
+template <typename... Observers>
+class ObservedMemory {
+ private:
+  Memory& memory;
+  std::tuple<Observers&...> observers;
+
+  template <typename Hook>
+  void Notify(const Hook& hook) noexcept {
+    std::apply([&hook](Observers&... each) { (hook(each), ...); },
+               observers);
+  }
+
+ public:
+  explicit ObservedMemory(Memory& memory, Observers&... observers)
+      : memory{memory}, observers{observers...} {}
+
+  [[nodiscard]] uint8_t LoadByte(const uint8_t addr) noexcept {
+    const uint8_t value = memory.LoadByte(addr);
+    const uint8_t bank = memory.GetCurrentBank();
+    Notify([&](auto& observer) { observer.OnMemRead(bank, addr, value); });
+    return value;
+  }
+
+  void WriteByte(const uint8_t addr, const uint8_t val) noexcept {
+    const uint8_t old_value = memory.ReadByte(addr);
+    memory.WriteByte(addr, val);
+    const MemoryWrite write{memory.GetCurrentBank(), addr, old_value,
+                            memory.ReadByte(addr)};
+    Notify([&](auto& observer) { observer.OnMemWrite(write); });
+  }
+
+  void SetCurrentBank(const uint8_t bank) noexcept {
+    const uint8_t from = memory.GetCurrentBank();
+    memory.SetCurrentBank(bank);
+    Notify([&](auto& observer) { observer.OnBankSwitch(from, bank); });
+  }
+};
+
+// Logs each retired instruction with the CPU state after it, and each byte
+// a store changed
+class LoggingObserver : public ExecutionObserver {
+ private:
+  const uint64_t& cycle;  // The emulator's cycle count
+
+ public:
+  explicit LoggingObserver(const uint64_t& cycle) : cycle{cycle} {}
+
+  void OnRetire(const Instruction& ins, const Cpu& cpu) noexcept;
+  void OnMemWrite(const MemoryWrite& write) noexcept;
+};
+
+#endif
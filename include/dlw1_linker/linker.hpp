@@ -0,0 +1,45 @@
+#ifndef LINKER_HPP
+#define LINKER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "dlw1_assembler/object_file.hpp"
+
+struct LinkInput {
+  std::string name;  // File the object came from, for error messages
+  ObjectFile object;
+};
+
+// Combines relocatable objects into one flat program image. Text sections
+// come first, in input order, followed by the data sections. A section that
+// fits in a bank is never split across banks, so its relative jumps still
+// reach their targets. The first input's text starts at address 0.
+class Linker {
+ private:
+  static constexpr uint32_t BANK_SIZE = 256;
+  static constexpr uint32_t MAX_IMAGE_SIZE = 0x10000;  // 256 banks
+
+  using SectionBases = std::array<uint32_t, SECTION_COUNT>;
+
+  [[nodiscard]] static std::vector<SectionBases> Place(
+      std::span<const LinkInput> inputs, uint32_t& image_size);
+
+ public:
+  // Reads object files and assembles source files, in parallel. Inputs that
+  // do not start with the object magic are treated as assembly source.
+  [[nodiscard]] static std::vector<LinkInput> Load(
+      const std::vector<std::string>& file_paths, std::size_t jobs);
+  // Resolves symbols and relocations across all inputs on `jobs` threads
+  // (0 uses every core)
+  [[nodiscard]] static std::vector<uint8_t> Link(
+      std::span<const LinkInput> inputs, std::size_t jobs);
+  static void LinkFiles(const std::vector<std::string>& file_paths,
+                        const std::string& output_file_path, std::size_t jobs);
+};
+
+#endif
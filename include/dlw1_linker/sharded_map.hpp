@@ -0,0 +1,64 @@
+#ifndef SHARDED_MAP_HPP
+#define SHARDED_MAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+// Hash map that many threads can insert into at once. Keys are spread over
+// independently locked shards, so concurrent writers only contend when their
+// keys hash to the same shard.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          std::size_t ShardCount = 64>
+class ShardedMap {
+ private:
+  // Shards sit on separate cache lines so their locks do not false-share
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Value, Hash> map;
+  };
+
+  std::array<Shard, ShardCount> shards;
+
+  [[nodiscard]] Shard& ShardFor(const Key& key) {
+    return shards[Hash{}(key) % ShardCount];
+  }
+  [[nodiscard]] const Shard& ShardFor(const Key& key) const {
+    return shards[Hash{}(key) % ShardCount];
+  }
+
+ public:
+  // Inserts the value unless the key is already present. Returns the value
+  // stored under the key and whether it was inserted.
+  std::pair<Value, bool> TryEmplace(const Key& key, Value value) {
+    Shard& shard = ShardFor(key);
+    const std::scoped_lock lock{shard.mutex};
+    const auto [it, inserted] = shard.map.try_emplace(key, std::move(value));
+    return {it->second, inserted};
+  }
+
+  [[nodiscard]] std::optional<Value> Find(const Key& key) const {
+    const Shard& shard = ShardFor(key);
+    const std::scoped_lock lock{shard.mutex};
+    const auto it = shard.map.find(key);
+    if (it == shard.map.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    std::size_t size = 0;
+    for (const Shard& shard : shards) {
+      const std::scoped_lock lock{shard.mutex};
+      size += shard.map.size();
+    }
+    return size;
+  }
+};
+
+#endif
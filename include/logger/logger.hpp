@@ -8,10 +8,12 @@
 
 class Logger {
  public:
+  // Console output goes to stdout, or to stderr when stdout carries the
+  // program's output
   static void Init(
       spdlog::level::level_enum console_level = spdlog::level::info,
       spdlog::level::level_enum file_level = spdlog::level::debug,
-      const std::string& initializer = "");
+      const std::string& initializer = "", bool console_to_stderr = false);
 
   [[nodiscard]] static std::shared_ptr<spdlog::logger>& GetLogger() noexcept;
   [[nodiscard]] static spdlog::level::level_enum StringToLevel(
@@ -1,30 +1,600 @@
 #include "dlw1_assembler/assembler.hpp"
 
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "dlw1_assembler/encoder.hpp"
+#include "dlw1_assembler/file_watcher.hpp"
 #include "dlw1_assembler/lexer.hpp"
+#include "dlw1_assembler/mapped_file.hpp"
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_assembler/optimizer.hpp"
+#include "dlw1_assembler/parser.hpp"
+#include "dlw1_assembler/program_image.hpp"
+#include "dlw1_assembler/statement.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
 #include "dlw1_assembler/token.hpp"
+#include "logger/logger.hpp"
 
-void Assembler::Assemble(const std::string& program_file_path) {
-  const std::ifstream program_file(program_file_path, std::ios::in);
-  if (!program_file) {
-    std::cout << "Failed to open program file";
-    // TODO: Handle error here
+static constexpr uint32_t BANK_BYTES = 0x100;
+static constexpr uint32_t MAX_IMAGE_SIZE = 0x10000;  // 256 banks of 256 bytes
+
+[[nodiscard]] static std::runtime_error LineError(
+    const std::size_t line_number, const std::string& message) {
+  return std::runtime_error("Line " + std::to_string(line_number + 1) + ": " +
+                            message);
+}
+
+// Source line without its comment, with runs of whitespace collapsed
+[[nodiscard]] static std::string SourceText(std::string_view text) {
+  text = text.substr(0, text.find(';'));
+  std::string normalized;
+  bool space = false;
+  for (const char c : text) {
+    if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+      space = !normalized.empty();
+    } else {
+      if (space) {
+        normalized += ' ';
+        space = false;
+      }
+      normalized += c;
+    }
+  }
+  return normalized;
+}
+
+Assembler::PlacedLine Assembler::PlaceLine(const std::string_view text,
+                                           const std::size_t line_number) {
+  auto it = line_cache.find(text);
+  if (it == line_cache.end()) {
+    const std::vector<Token> tokens = Lexer::TokenizeLine(text, line_number);
+    it = line_cache
+             .emplace(std::string(text),
+                      CachedLine{.statement =
+                                     Parser::ParseLine(tokens, line_number)})
+             .first;
+    ++stats.parsed_lines;
+  }
+
+  CachedLine& line = it->second;
+  if (line.generation != generation) {
+    line.generation = generation;
+    line.occurrences = 0;
+    ++live_lines;
+  }
+
+  std::size_t encoding = 0;
+  if (!line.statement.ReferencedSymbol().empty()) {
+    encoding = line.occurrences++;
+    if (encoding == line.encodings.size()) {
+      line.encodings.emplace_back();
+    }
+  }
+  return {.line = &line, .encoding = encoding, .line_number = line_number};
+}
+
+void Assembler::ReadLines(std::string_view source) {
+  ++generation;
+  live_lines = 0;
+  stats = {};
+  placed_lines.clear();
+  optimized_lines.clear();
+
+  std::size_t line_number = 0;
+  while (!source.empty()) {
+    const std::size_t newline = source.find('\n');
+    const std::string_view text = source.substr(0, newline);
+
+    placed_lines.push_back(PlaceLine(text, line_number));
+
+    ++line_number;
+    source.remove_prefix(newline == std::string_view::npos ? source.size()
+                                                           : newline + 1);
+  }
+  stats.lines = line_number;
+}
+
+void Assembler::Optimize() {
+  std::vector<const Statement*> program;
+  program.reserve(placed_lines.size());
+  for (const PlacedLine& placed : placed_lines) {
+    program.push_back(&placed.line->statement);
+  }
+
+  OptimizationResult result = Optimizer::Optimize(program);
+  if (result.numeric_addresses) {
+    LOG_WARN(
+        "Optimizer removed no instructions: program uses numeric or "
+        "register addresses");
+  }
+
+  for (auto& [index, statement] : result.rewrites) {
+    placed_lines[index].line = &optimized_lines.emplace_back(
+        CachedLine{.statement = std::move(statement)});
+    placed_lines[index].encoding = 0;
+  }
+  stats.eliminated_instructions = result.eliminated_instructions;
+}
+
+void Assembler::Layout(const bool relocatable) {
+  // Each section has its own location counter; .org is section-relative
+  std::array<uint32_t, SECTION_COUNT> offsets{};
+  section_sizes = {};
+  Section section = Section::TEXT;
+
+  for (PlacedLine& placed : placed_lines) {
+    const Statement& statement = placed.line->statement;
+    if (statement.type == StatementType::DIRECTIVE) {
+      switch (statement.keyword) {
+        case TokenType::DIRECTIVE_TEXT:
+          section = Section::TEXT;
+          break;
+        case TokenType::DIRECTIVE_DATA:
+          section = Section::DATA;
+          break;
+        case TokenType::DIRECTIVE_ORG:
+          offsets.at(static_cast<std::size_t>(section)) =
+              static_cast<uint32_t>(statement.operands[0].value);
+          break;
+        default:
+          break;
+      }
+    }
+
+    uint32_t& offset = offsets.at(static_cast<std::size_t>(section));
+    placed.section = section;
+    placed.address = offset;
+    offset += Encoder::Size(statement);
+    if (offset > MAX_IMAGE_SIZE) {
+      throw LineError(placed.line_number,
+                      "Program exceeds the 64KB address space");
+    }
+
+    uint32_t& end = section_sizes.at(static_cast<std::size_t>(section));
+    end = std::max(end, offset);
+  }
+
+  // In a flat image the data section follows the text section
+  const uint32_t data_base =
+      relocatable ? 0 : section_sizes[static_cast<std::size_t>(Section::TEXT)];
+  if (data_base + section_sizes[static_cast<std::size_t>(Section::DATA)] >
+      MAX_IMAGE_SIZE) {
+    throw std::runtime_error("Program exceeds the 64KB address space");
+  }
+
+  StringMap<uint16_t> new_symbols;
+  new_symbols.reserve(symbols.size());
+  for (PlacedLine& placed : placed_lines) {
+    if (placed.section == Section::DATA) {
+      placed.address += data_base;
+    }
+
+    const std::string& label = placed.line->statement.label;
+    if (label.empty()) {
+      continue;
+    }
+    if (placed.address >= MAX_IMAGE_SIZE) {
+      throw LineError(placed.line_number,
+                      "Label '" + label + "' is past the end of memory");
+    }
+
+    const auto address = static_cast<uint16_t>(placed.address);
+    if (!new_symbols.emplace(label, address).second) {
+      throw LineError(placed.line_number, "Duplicate label '" + label + "'");
+    }
+
+    const auto previous = symbols.find(label);
+    if (previous == symbols.end() || previous->second != address) {
+      ++stats.changed_labels;
+    }
+  }
+  symbols = std::move(new_symbols);
+}
+
+std::size_t Assembler::Encode(const bool relocatable) {
+  uint32_t image_size = 0;
+  for (const PlacedLine& placed : placed_lines) {
+    const Statement& statement = placed.line->statement;
+    if (Encoder::Size(statement) == 0) {
+      continue;
+    }
+
+    // Relocatable label fields get a placeholder the linker overwrites
+    const auto address = static_cast<uint16_t>(placed.address);
+    uint16_t target = 0;
+    const std::string_view symbol = statement.ReferencedSymbol();
+    if (!symbol.empty() && relocatable) {
+      target = address;
+    } else if (!symbol.empty()) {
+      const auto it = symbols.find(symbol);
+      if (it == symbols.end()) {
+        throw LineError(placed.line_number,
+                        "Undefined label '" + std::string(symbol) + "'");
+      }
+      target = it->second;
+    }
+
+    // Only label references depend on where things were placed
+    Encoding& encoding = placed.line->encodings[placed.encoding];
+    if (!encoding.encoded ||
+        (!symbol.empty() &&
+         (encoding.address != address || encoding.target != target))) {
+      encoding.bytes.clear();
+      if (statement.line_number == placed.line_number) {
+        Encoder::Encode(statement, address, target, jump_form,
+                        encoding.bytes);
+      } else {
+        // A repeated line; errors must name this occurrence
+        Statement occurrence = statement;
+        occurrence.line_number = placed.line_number;
+        Encoder::Encode(occurrence, address, target, jump_form,
+                        encoding.bytes);
+      }
+      encoding.encoded = true;
+      encoding.address = address;
+      encoding.target = target;
+      ++stats.encoded_lines;
+    }
+
+    image_size = std::max(
+        image_size,
+        placed.address + static_cast<uint32_t>(encoding.bytes.size()));
+  }
+  return image_size;
+}
+
+void Assembler::Emit(const std::span<uint8_t> image) const noexcept {
+  for (const PlacedLine& placed : placed_lines) {
+    std::ranges::copy(placed.Bytes(),
+                      std::next(image.begin(), placed.address));
+  }
+}
+
+ProgramImage Assembler::BuildImage(const std::span<const uint8_t> image) const {
+  // Section that placed each byte, plus one; zero for gaps
+  std::vector<uint8_t> owners(image.size());
+  for (const PlacedLine& placed : placed_lines) {
+    std::fill_n(std::next(owners.begin(), placed.address),
+                placed.Bytes().size(),
+                static_cast<uint8_t>(static_cast<uint8_t>(placed.section) + 1));
+  }
+
+  // Protection is per bank, and code can only store to the bank it runs in,
+  // so text that shares a bank with data stays writable. Read-only text
+  // segments end at bank boundaries to protect every bank they can.
+  constexpr auto text_owner = static_cast<uint8_t>(Section::TEXT) + 1;
+  std::bitset<MAX_IMAGE_SIZE / BANK_BYTES> data_banks;
+  for (std::size_t address = 0; address < image.size(); ++address) {
+    if (owners[address] != 0 && owners[address] != text_owner) {
+      data_banks.set(address / BANK_BYTES);
+    }
+  }
+
+  ProgramImage program;
+  if (const auto start = symbols.find("_start"); start != symbols.end()) {
+    program.entry = start->second;
+  }
+  std::size_t warned_bank = data_banks.size();
+  for (std::size_t begin = 0; begin < image.size();) {
+    const uint8_t owner = owners[begin];
+    const bool read_only = owner == text_owner && read_only_text;
+    std::size_t end = begin + 1;
+    while (end < image.size() && owners[end] == owner &&
+           !(read_only && end % BANK_BYTES == 0)) {
+      ++end;
+    }
+    if (owner != 0) {
+      const std::size_t bank = begin / BANK_BYTES;
+      const bool protect = read_only && !data_banks.test(bank);
+      if (read_only && !protect && bank != warned_bank) {
+        LOG_WARN("Text in bank {} shares the bank with data; left writable",
+                 bank);
+        warned_bank = bank;
+      }
+      program.segments.push_back(
+          {static_cast<uint16_t>(begin),
+           protect ? ImageSegment::READ_ONLY : uint8_t{0},
+           image.subspan(begin, end - begin)});
+    }
+    begin = end;
+  }
+  return program;
+}
+
+ObjectFile Assembler::BuildObject() const {
+  ObjectFile object;
+  for (std::size_t i = 0; i < SECTION_COUNT; ++i) {
+    object.sections.at(i).resize(section_sizes.at(i));
+  }
+
+  // Symbol declarations may appear anywhere in the file
+  StringMap<std::size_t> globals;
+  StringMap<std::size_t> externs;
+  for (const PlacedLine& placed : placed_lines) {
+    const Statement& statement = placed.line->statement;
+    if (statement.keyword != TokenType::DIRECTIVE_GLOBAL &&
+        statement.keyword != TokenType::DIRECTIVE_EXTERN) {
+      continue;
+    }
+    StringMap<std::size_t>& declared =
+        statement.keyword == TokenType::DIRECTIVE_GLOBAL ? globals : externs;
+    for (const Operand& operand : statement.operands) {
+      declared.try_emplace(operand.symbol, placed.line_number);
+    }
+  }
+
+  StringMap<uint16_t> indices;
+  const auto add_symbol = [&object, &indices](ObjectSymbol symbol) {
+    if (object.symbols.size() > UINT16_MAX) {
+      throw std::runtime_error("Too many symbols for an object file");
+    }
+    indices.emplace(symbol.name, static_cast<uint16_t>(object.symbols.size()));
+    object.symbols.push_back(std::move(symbol));
+  };
+
+  for (const PlacedLine& placed : placed_lines) {
+    const CachedLine& line = *placed.line;
+    std::ranges::copy(placed.Bytes(),
+                      std::next(object.Contents(placed.section).begin(),
+                                placed.address));
+
+    const std::string& label = line.statement.label;
+    if (label.empty()) {
+      continue;
+    }
+    if (const auto it = externs.find(label); it != externs.end()) {
+      throw LineError(it->second,
+                      "Label '" + label + "' is declared extern but defined");
+    }
+    add_symbol({.name = label,
+                .binding = globals.contains(label) ? SymbolBinding::GLOBAL
+                                                   : SymbolBinding::LOCAL,
+                .section = placed.section,
+                .offset = static_cast<uint16_t>(placed.address)});
+  }
+
+  for (const auto& [name, line_number] : globals) {
+    if (!indices.contains(name)) {
+      throw LineError(line_number, "Global label '" + name + "' is undefined");
+    }
+  }
+
+  // Imports follow the definitions, in declaration order
+  for (const PlacedLine& placed : placed_lines) {
+    const Statement& statement = placed.line->statement;
+    if (statement.keyword != TokenType::DIRECTIVE_EXTERN) {
+      continue;
+    }
+    for (const Operand& operand : statement.operands) {
+      if (!indices.contains(operand.symbol)) {
+        add_symbol({.name = operand.symbol, .binding = SymbolBinding::EXTERN});
+      }
+    }
+  }
+
+  for (const PlacedLine& placed : placed_lines) {
+    const Statement& statement = placed.line->statement;
+    const std::string_view symbol = statement.ReferencedSymbol();
+    if (symbol.empty()) {
+      continue;
+    }
+    const auto it = indices.find(symbol);
+    if (it == indices.end()) {
+      throw LineError(placed.line_number,
+                      "Undefined label '" + std::string(symbol) +
+                          "' (declare external labels with .extern)");
+    }
+    if (object.relocations.size() >= UINT16_MAX) {
+      throw std::runtime_error("Too many relocations for an object file");
+    }
+    object.relocations.push_back(
+        {.section = placed.section,
+         .offset = static_cast<uint16_t>(placed.address),
+         .type = Encoder::RelocationFor(statement, jump_form),
+         .symbol = it->second});
+  }
+
+  return object;
+}
+
+DebugInfo Assembler::BuildDebugInfo(std::string_view source,
+                                    std::string file_name) const {
+  std::vector<std::string_view> texts;
+  while (!source.empty()) {
+    const std::size_t newline = source.find('\n');
+    texts.push_back(source.substr(0, newline));
+    source.remove_prefix(newline == std::string_view::npos ? source.size()
+                                                           : newline + 1);
   }
 
-  std::stringstream program_contents;
-  program_contents << program_file.rdbuf();
+  DebugInfo info{.file = std::move(file_name)};
+  std::array<std::string_view, SECTION_COUNT> labels{};
+  for (const PlacedLine& placed : placed_lines) {
+    const CachedLine& line = *placed.line;
+    std::string_view& label =
+        labels.at(static_cast<std::size_t>(placed.section));
+    if (!line.statement.label.empty()) {
+      label = line.statement.label;
+    }
+    if (placed.Bytes().empty() || placed.line_number >= texts.size()) {
+      continue;
+    }
+    info.lines.push_back(
+        {.address = static_cast<uint16_t>(placed.address),
+         .size = static_cast<uint16_t>(placed.Bytes().size()),
+         .line = static_cast<uint32_t>(placed.line_number + 1),
+         .label = std::string(label),
+         .text = SourceText(texts[placed.line_number])});
+  }
+  // Data is placed after text, but .org can reorder lines within a section
+  std::ranges::stable_sort(info.lines, {}, &DebugLine::address);
+  return info;
+}
 
-  const std::vector<Token> tokens =
-      Lexer::Tokenize(std::move(program_contents));
+void Assembler::Finish() {
+  // Forget lines that are no longer part of the program
+  if (live_lines != line_cache.size()) {
+    std::erase_if(line_cache, [this](const auto& entry) {
+      return entry.second.generation != generation;
+    });
+  }
+}
 
-  // Print all tokens for testing
-  for (const Token& t : tokens) {
-    std::cout << t.text << ' ' << t.type << ' ' << t.line_number << '\n';
+void Assembler::Assemble(const std::string_view source,
+                         const ImageAllocator& allocate) {
+  ReadLines(source);
+  if (optimize) {
+    Optimize();
   }
+
+  // Everything that can fail happens before the output is allocated
+  Layout(false);
+  const std::size_t image_size = Encode(false);
+  Emit(allocate(image_size));
+
+  Finish();
+  stats.image_size = image_size;
+}
+
+std::vector<uint8_t> Assembler::Assemble(const std::string_view source) {
+  std::vector<uint8_t> image;
+  Assemble(source, [&image](const std::size_t size) {
+    image.resize(size);
+    return std::span<uint8_t>{image};
+  });
+  return image;
 }
+
+std::vector<uint8_t> Assembler::AssembleImage(const std::string_view source) {
+  const std::vector<uint8_t> image = Assemble(source);
+  const ProgramImage program = BuildImage(image);
+  std::vector<uint8_t> bytes(program.SerializedSize());
+  program.Serialize(bytes);
+  stats.image_size = bytes.size();
+  return bytes;
+}
+
+ObjectFile Assembler::AssembleObject(const std::string_view source) {
+  ReadLines(source);
+  if (optimize) {
+    Optimize();
+  }
+  Layout(true);
+  static_cast<void>(Encode(true));
+  ObjectFile object = BuildObject();
+
+  Finish();
+  stats.image_size = object.SerializedSize();
+  return object;
+}
+
+void Assembler::AssembleFile(const std::string& program_file_path,
+                             const std::string& output_file_path,
+                             const OutputFormat format) {
+  const InputFile program_file{program_file_path};
+
+  // The encoder writes straight into the output file's pages
+  std::optional<OutputFile> output_file;
+  if (format == OutputFormat::OBJECT) {
+    const ObjectFile object = AssembleObject(program_file.View());
+    object.Serialize(
+        output_file.emplace(output_file_path, object.SerializedSize()).Data());
+  } else if (format == OutputFormat::SECTIONED) {
+    const std::vector<uint8_t> image = AssembleImage(program_file.View());
+    std::ranges::copy(image,
+                      output_file.emplace(output_file_path, image.size())
+                          .Data()
+                          .begin());
+  } else {
+    Assemble(program_file.View(), [&](const std::size_t size) {
+      return output_file.emplace(output_file_path, size).Data();
+    });
+  }
+  output_file->Commit();
+
+  if (!symbol_map_path.empty() && format != OutputFormat::OBJECT) {
+    const DebugInfo info =
+        BuildDebugInfo(program_file.View(), program_file_path);
+    OutputFile symbol_file{symbol_map_path, info.SerializedSize()};
+    info.Serialize(symbol_file.Data());
+    symbol_file.Commit();
+    LOG_DEBUG("Wrote {} debug lines to {}", info.lines.size(),
+              symbol_map_path);
+  }
+
+  LOG_INFO("Assembled {} lines into {} bytes: {}", stats.lines,
+           stats.image_size, output_file_path);
+  if (optimize) {
+    LOG_INFO("Optimizer eliminated {} instructions",
+             stats.eliminated_instructions);
+  }
+  LOG_DEBUG("{} lines parsed, {} lines encoded, {} labels changed",
+            stats.parsed_lines, stats.encoded_lines, stats.changed_labels);
+}
+
+void Assembler::Watch(const std::string& program_file_path,
+                      const std::string& output_file_path,
+                      const OutputFormat format) {
+  FileWatcher watcher{program_file_path};
+  LOG_INFO("Watching {} for changes", program_file_path);
+
+  while (true) {
+    watcher.WaitForChange();
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      AssembleFile(program_file_path, output_file_path, format);
+      const std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      LOG_INFO("Rebuilt in {:.3f} ms ({} of {} lines parsed)", elapsed.count(),
+               stats.parsed_lines, stats.lines);
+    } catch (const std::exception& e) {
+      LOG_ERROR("{}", e.what());
+    }
+  }
+}
+
+void Assembler::SetOptimization(const bool enabled) noexcept {
+  optimize = enabled;
+}
+
+void Assembler::SetPositionIndependent(const bool enabled) noexcept {
+  const JumpForm form = enabled ? JumpForm::RELATIVE : JumpForm::ABSOLUTE;
+  if (form == jump_form) {
+    return;
+  }
+  jump_form = form;
+  // Cached label jumps were encoded in the other form
+  for (auto& [text, line] : line_cache) {
+    if (!line.statement.ReferencedSymbol().empty()) {
+      for (Encoding& encoding : line.encodings) {
+        encoding.encoded = false;
+      }
+    }
+  }
+}
+
+void Assembler::SetReadOnlyText(const bool enabled) noexcept {
+  read_only_text = enabled;
+}
+
+void Assembler::SetSymbolMapPath(std::string path) noexcept {
+  symbol_map_path = std::move(path);
+}
+
+const AssemblyStats& Assembler::GetStats() const noexcept { return stats; }
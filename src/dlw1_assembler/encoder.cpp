@@ -0,0 +1,211 @@
+#include "dlw1_assembler/encoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_assembler/statement.hpp"
+#include "dlw1_assembler/token.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,hicpp-signed-bitwise,readability-magic-numbers)
+
+int32_t Encoder::RelativeOffset(const uint16_t address,
+                                const uint16_t target) noexcept {
+  // Relative to the PC after fetch, which wraps within the bank
+  const auto next_pc = static_cast<uint8_t>(address + INSTRUCTION_SIZE);
+  return static_cast<uint8_t>(target) - next_pc;
+}
+
+uint16_t Encoder::RelativeField(const int32_t offset) noexcept {
+  return static_cast<uint16_t>((static_cast<uint16_t>(offset) & 0x1FFU)
+                               << 7U);
+}
+
+uint8_t Encoder::OpcodeBits(const TokenType mnemonic) noexcept {
+  switch (mnemonic) {
+    case TokenType::ADD:
+      return 0b000;
+    case TokenType::SUB:
+      return 0b001;
+    case TokenType::LOAD:
+    case TokenType::BANK:
+      return 0b010;
+    case TokenType::STORE:
+    case TokenType::MOV:
+      return 0b011;
+    case TokenType::JUMP:
+    case TokenType::HALT:
+      return 0b100;
+    case TokenType::JUMPZ:
+      return 0b101;
+    case TokenType::JUMPNZ:
+      return 0b110;
+    case TokenType::JUMPN:
+      return 0b111;
+    default:
+      return 0;
+  }
+}
+
+uint16_t Encoder::Size(const Statement& statement) noexcept {
+  switch (statement.type) {
+    case StatementType::INSTRUCTION:
+      return INSTRUCTION_SIZE;
+    case StatementType::DIRECTIVE:
+      if (statement.keyword == TokenType::DIRECTIVE_BYTE) {
+        return static_cast<uint16_t>(statement.operands.size());
+      }
+      if (statement.keyword == TokenType::DIRECTIVE_WORD) {
+        return static_cast<uint16_t>(statement.operands.size() * 2);
+      }
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+uint16_t Encoder::EncodeInstruction(const Statement& statement,
+                                    const uint16_t address,
+                                    const uint16_t target,
+                                    const JumpForm jump_form) {
+  const std::vector<Operand>& operands = statement.operands;
+  const auto opcode = static_cast<uint16_t>(OpcodeBits(statement.keyword)
+                                            << 1U);
+
+  // Immediates resolve to the in-bank address of their label, if any
+  const auto immediate = [target](const Operand& operand) -> uint16_t {
+    const int32_t value = operand.symbol.empty() ? operand.value : target;
+    return static_cast<uint16_t>(static_cast<uint8_t>(value));
+  };
+
+  switch (statement.keyword) {
+    case TokenType::ADD:
+    case TokenType::SUB: {
+      const uint16_t src = operands[0].reg;
+      const uint16_t dest = operands[2].reg;
+      if (operands[1].type == OperandType::IMMEDIATE) {
+        return (immediate(operands[1]) << 8U) | (dest << 6U) | (src << 4U) |
+               opcode | 0b1U;
+      }
+      const uint16_t src2 = operands[1].reg;
+      return (dest << 8U) | (src2 << 6U) | (src << 4U) | opcode;
+    }
+    case TokenType::LOAD:
+    case TokenType::STORE: {
+      const uint16_t reg = operands[0].reg;
+      const Operand& address_operand = operands[1];
+      switch (address_operand.type) {
+        case OperandType::IMMEDIATE:
+          return (immediate(address_operand) << 8U) | (reg << 6U) | opcode |
+                 0b1U;
+        case OperandType::REGISTER:
+          // LOAD dest, src and STORE src, dest share one register layout
+          if (statement.keyword == TokenType::LOAD) {
+            return (reg << 8U) | (uint16_t{address_operand.reg} << 4U) |
+                   opcode;
+          }
+          return (uint16_t{address_operand.reg} << 8U) | (reg << 4U) | opcode;
+        default:
+          return (static_cast<uint16_t>(
+                      static_cast<uint8_t>(address_operand.value))
+                  << 8U) |
+                 (reg << 6U) | (uint16_t{address_operand.reg} << 4U) | opcode |
+                 0b1U;
+      }
+    }
+    case TokenType::MOV:
+      return (uint16_t{operands[1].reg} << 8U) | (0b11U << 6U) |
+             (uint16_t{operands[0].reg} << 4U) | opcode;
+    case TokenType::BANK:
+      return (immediate(operands[0]) << 8U) | (0b1111U << 4U) | opcode;
+    case TokenType::JUMP:
+    case TokenType::JUMPZ:
+    case TokenType::JUMPNZ:
+    case TokenType::JUMPN: {
+      const Operand& operand = operands[0];
+      int32_t offset = operand.value;
+      switch (operand.type) {
+        case OperandType::IMMEDIATE:
+          return (immediate(operand) << 8U) | opcode | 0b1U;
+        case OperandType::REGISTER:
+          return (uint16_t{operand.reg} << 4U) | opcode;
+        case OperandType::SYMBOL: {
+          if ((address >> 8U) != (target >> 8U)) {
+            throw std::runtime_error(
+                "Line " + std::to_string(statement.line_number + 1) +
+                ": Jump target '" + operand.symbol +
+                "' is in a different bank");
+          }
+          if (jump_form == JumpForm::ABSOLUTE) {
+            return (immediate(operand) << 8U) | opcode | 0b1U;
+          }
+          offset = RelativeOffset(address, target);
+          break;
+        }
+        default:
+          break;
+      }
+      return RelativeField(offset) | (0b001U << 4U) | opcode | 0b1U;
+    }
+    case TokenType::HALT:
+      return (0xFFU << 8U) | opcode;
+    default:
+      return 0;
+  }
+}
+
+void Encoder::Encode(const Statement& statement, const uint16_t address,
+                     const uint16_t target, const JumpForm jump_form,
+                     std::vector<uint8_t>& bytes) {
+  if (statement.type == StatementType::INSTRUCTION) {
+    const uint16_t word =
+        EncodeInstruction(statement, address, target, jump_form);
+    bytes.push_back(static_cast<uint8_t>(word >> 8U));
+    bytes.push_back(static_cast<uint8_t>(word));
+    return;
+  }
+
+  for (const Operand& operand : statement.operands) {
+    if (statement.keyword == TokenType::DIRECTIVE_BYTE) {
+      bytes.push_back(static_cast<uint8_t>(operand.value));
+    } else if (statement.keyword == TokenType::DIRECTIVE_WORD) {
+      bytes.push_back(static_cast<uint8_t>(operand.value >> 8));
+      bytes.push_back(static_cast<uint8_t>(operand.value));
+    }
+  }
+}
+
+RelocationType Encoder::RelocationFor(const Statement& statement,
+                                      const JumpForm jump_form) noexcept {
+  for (const Operand& operand : statement.operands) {
+    if (operand.type == OperandType::SYMBOL &&
+        jump_form == JumpForm::RELATIVE) {
+      return RelocationType::RELATIVE_9;
+    }
+  }
+  return RelocationType::ABSOLUTE_8;
+}
+
+void Encoder::Relocate(const RelocationType type, const uint16_t address,
+                       const uint16_t target,
+                       const std::span<uint8_t, INSTRUCTION_SIZE> instruction) {
+  uint16_t word = static_cast<uint16_t>(instruction[0] << 8U) | instruction[1];
+  if (type == RelocationType::ABSOLUTE_8) {
+    word = static_cast<uint16_t>((word & 0x00FFU) |
+                                 (static_cast<uint8_t>(target) << 8U));
+  } else {
+    if ((address >> 8U) != (target >> 8U)) {
+      throw std::runtime_error("Jump target is in a different bank");
+    }
+    word = static_cast<uint16_t>((word & 0x007FU) |
+                                 RelativeField(RelativeOffset(address, target)));
+  }
+  instruction[0] = static_cast<uint8_t>(word >> 8U);
+  instruction[1] = static_cast<uint8_t>(word);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,hicpp-signed-bitwise,readability-magic-numbers)
@@ -0,0 +1,91 @@
+#include "dlw1_assembler/file_watcher.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+FileWatcher::FileWatcher(const std::string& file_path)
+    : path(std::filesystem::absolute(file_path)), inotify_fd(-1) {
+  std::error_code error_code;
+  last_write_time = std::filesystem::last_write_time(path, error_code);
+
+#ifdef __linux__
+  inotify_fd = inotify_init1(IN_CLOEXEC);
+  if (inotify_fd < 0) {
+    throw std::runtime_error("Failed to initialize inotify: " +
+                             std::string(std::strerror(errno)));
+  }
+
+  // Watch the directory so editors that replace the file on save are seen
+  if (inotify_add_watch(inotify_fd, path.parent_path().c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+    close(inotify_fd);
+    throw std::runtime_error("Failed to watch " +
+                             path.parent_path().string() + ": " +
+                             std::strerror(errno));
+  }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+  if (inotify_fd >= 0) {
+    close(inotify_fd);
+  }
+#endif
+}
+
+void FileWatcher::WaitForChange() {
+#ifdef __linux__
+  const std::string file_name = path.filename().string();
+  alignas(inotify_event) std::array<char, 4096> buffer{};
+
+  while (true) {
+    const ssize_t length = read(inotify_fd, buffer.data(), buffer.size());
+    if (length < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed to read inotify events: " +
+                               std::string(std::strerror(errno)));
+    }
+
+    for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);) {
+      // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto* event =
+          reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+      if (event->len > 0 && file_name == event->name) {
+        return;
+      }
+      // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      offset += sizeof(inotify_event) + event->len;
+    }
+  }
+#else
+  constexpr std::chrono::milliseconds POLL_INTERVAL{50};
+
+  while (true) {
+    std::this_thread::sleep_for(POLL_INTERVAL);
+
+    std::error_code error_code;
+    const auto write_time = std::filesystem::last_write_time(path, error_code);
+    if (!error_code && write_time != last_write_time) {
+      last_write_time = write_time;
+      return;
+    }
+  }
+#endif
+}
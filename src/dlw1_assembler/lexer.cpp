@@ -2,37 +2,40 @@
 
 #include <cctype>
 #include <cstddef>
+#include <iterator>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "dlw1_assembler/keywords.hpp"
 #include "dlw1_assembler/linestream.hpp"
 #include "dlw1_assembler/token.hpp"
 
-void Lexer::CleanLine(std::string& line) {
-  const std::string whitespace_chars = " \f\n\r\t\v";
+std::string_view Lexer::CleanLine(std::string_view line) {
+  constexpr std::string_view whitespace_chars = " \f\n\r\t\v";
 
   // Remove leading whitespace
   const std::size_t start = line.find_first_not_of(whitespace_chars);
-  if (start == std::string::npos) {
-    line.clear();
-    return;
+  if (start == std::string_view::npos) {
+    return {};
   }
-  line.erase(0, start);
+  line.remove_prefix(start);
 
   // Remove comment
   const std::size_t semicolon_pos = line.find(';');
-  if (semicolon_pos != std::string::npos) {
-    line.erase(semicolon_pos);
+  if (semicolon_pos != std::string_view::npos) {
+    line = line.substr(0, semicolon_pos);
   }
 
   // Remove trailing whitespace
   const std::size_t end = line.find_last_not_of(whitespace_chars);
-  if (end == std::string::npos) {
-    line.clear();
-    return;
+  if (end == std::string_view::npos) {
+    return {};
   }
-  line.erase(end + 1);
+  return line.substr(0, end + 1);
 }
 
 Token Lexer::TokenizeNumber(LineStream& linestream,
@@ -84,13 +87,10 @@ Token Lexer::TokenizeWord(LineStream& linestream,
   }
   token.text = text;
 
-  if (text.front() == '.') {
+  if (const std::optional<TokenType> keyword = Keywords::Lookup(text)) {
+    token.type = *keyword;
+  } else if (text.front() == '.') {
     token.type = TokenType::DIRECTIVE;
-  } else if ((text.front() == 'r' || text.front() == 'R') &&
-             text.size() == REGISTER_NAME_LENGTH &&
-             (VALID_REGISTER_SUFFIXES.find(text[1]) !=
-              std::string_view::npos)) {
-    token.type = TokenType::REGISTER;
   } else {
     token.type = TokenType::IDENTIFIER;
   }
@@ -128,53 +128,58 @@ Token Lexer::TokenizeSpecialCharacter(LineStream& linestream,
       token.type = TokenType::RPARENTHESES;
       break;
     default:
-      // TODO: Handle error here
-      break;
+      throw std::runtime_error(
+          "Line " + std::to_string(current_line_number + 1) +
+          ": Unexpected character '" + std::string(1, current_character) +
+          "'");
   }
 
   return token;
 }
 
-std::vector<Token> Lexer::Tokenize(std::stringstream program_contents) {
-  std::size_t current_line_number = 0;
-
+std::vector<Token> Lexer::TokenizeLine(const std::string_view line,
+                                       const std::size_t line_number) {
   std::vector<Token> tokens;
 
-  std::string line;
-  while (std::getline(program_contents, line)) {
-    CleanLine(line);
+  LineStream linestream{CleanLine(line)};
+  while (!linestream.EndOfStream()) {
+    const char current_character = linestream.Peek();
 
-    // TODO: Reconsider this logic for error messages
-    if (line.empty()) {
-      ++current_line_number;
+    // Skip whitespace between tokens
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (std::isspace(current_character)) {
+      linestream.Skip();
       continue;
     }
 
-    LineStream linestream{line};
-    while (!linestream.EndOfStream()) {
-      const char current_character = linestream.Peek();
+    Token token;
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (std::isdigit(current_character)) {
+      token = TokenizeNumber(linestream, line_number);
+    }
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    else if (std::isalpha(current_character) || current_character == '.' ||
+             current_character == '_') {
+      token = TokenizeWord(linestream, line_number);
+    } else {
+      token = TokenizeSpecialCharacter(linestream, line_number);
+    }
+    tokens.push_back(token);
+  }
 
-      // Skip whitespace between tokens
-      // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-      if (std::isspace(current_character)) {
-        linestream.Skip();
-        continue;
-      }
+  return tokens;
+}
 
-      Token token;
-      // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-      if (std::isdigit(current_character)) {
-        token = TokenizeNumber(linestream, current_line_number);
-      }
-      // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-      else if (std::isalpha(current_character) || current_character == '.' ||
-               current_character == '_') {
-        token = TokenizeWord(linestream, current_line_number);
-      } else {
-        token = TokenizeSpecialCharacter(linestream, current_line_number);
-      }
-      tokens.push_back(token);
-    }
+std::vector<Token> Lexer::Tokenize(std::stringstream program_contents) {
+  std::size_t current_line_number = 0;
+
+  std::vector<Token> tokens;
+
+  std::string line;
+  while (std::getline(program_contents, line)) {
+    std::vector<Token> line_tokens = TokenizeLine(line, current_line_number);
+    tokens.insert(tokens.end(), std::make_move_iterator(line_tokens.begin()),
+                  std::make_move_iterator(line_tokens.end()));
 
     ++current_line_number;
   }
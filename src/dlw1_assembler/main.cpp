@@ -1,12 +1,207 @@
 #include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
+#include "cxxopts.hpp"
 #include "dlw1_assembler/assembler.hpp"
+#include "dlw1_assembler/mapped_file.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
+#include "logger/logger.hpp"
+#include "spdlog/common.h"
+
+[[nodiscard]] static spdlog::level::level_enum ParseLogLevel(
+    const std::string& level_str, std::string_view option_name) {
+  try {
+    return Logger::StringToLevel(level_str);
+  } catch (const std::exception& e) {
+    throw std::runtime_error(std::string("Error reading ") +
+                             std::string(option_name) +
+                             " configuration: " + e.what());
+  }
+}
+
+[[nodiscard]] static std::string GetFilePath(
+    const cxxopts::ParseResult& parsed_options, std::string_view option_name) {
+  try {
+    return parsed_options[std::string(option_name)].as<std::string>();
+  } catch (const cxxopts::exceptions::exception& e) {
+    throw std::runtime_error(std::string("Error reading ") +
+                             std::string(option_name) + ": " + e.what());
+  }
+}
 
 // clang-tidy reports false positive
 // NOLINTNEXTLINE(bugprone-exception-escape)
-int main() {
-  const Assembler assembler{};
-  assembler.Assemble("sample_program.s");
+int main(int argc, char* argv[]) {
+  try {
+    cxxopts::Options options("DLW-1", "DLW-1 Assembler");
+    options.add_options()("f,file", "Path to the assembly file to assemble (- for stdin)",
+                          cxxopts::value<std::string>())(
+        "o,output",
+        "Path to the output file, - for stdout (default: input with .bin or "
+        ".o extension)",
+        cxxopts::value<std::string>())(
+        "r,relocatable", "Write a relocatable object file for dlw1-ld")(
+        "s,sectioned",
+        "Write an image with a header, entry point and segment table instead "
+        "of a flat image")(
+        "read-only-text",
+        "Mark the text segments of a sectioned image read-only")(
+        "O,optimize", "Run the peephole optimizer before encoding")(
+        "g,debug-symbols",
+        "Write a symbol map for the emulator next to the output (.dbg)")(
+        "no-pic",
+        "Encode jumps to labels with absolute in-bank addresses instead of "
+        "PC-relative offsets")(
+        "w,watch", "Re-assemble whenever the assembly file changes")(
+        "c,console-level", "Console log level [debug, info, warn, error, off]",
+        cxxopts::value<std::string>()->default_value("info"))(
+        "l,file-level", "File log level [debug, info, warn, error, off]",
+        cxxopts::value<std::string>()->default_value("debug"))(
+        "version", "Print version information")("help",
+                                                "Print usage information");
+
+    cxxopts::ParseResult parsed_options;
+    try {
+      parsed_options = options.parse(argc, argv);
+    } catch (const cxxopts::exceptions::exception& e) {
+      throw std::runtime_error("Failed to parse command line arguments: " +
+                               std::string(e.what()));
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("help")) {
+      std::cout << options.help() << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("version")) {
+      std::cout << PROJECT_VERSION << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    const spdlog::level::level_enum console_level = ParseLogLevel(
+        parsed_options["console-level"].as<std::string>(), "console-level");
+    const spdlog::level::level_enum file_level = ParseLogLevel(
+        parsed_options["file-level"].as<std::string>(), "file-level");
+    // An image written to stdout must not be mixed with log lines
+    const bool to_stdout =
+        parsed_options.count("output") > 0 &&
+        GetFilePath(parsed_options, "output") == STANDARD_STREAM_PATH;
+    Logger::Init(console_level, file_level, APP_NAME, to_stdout);
+
+    std::string program_file_path;
+
+    // In DEBUG builds, use sample program if no file is specified
+    // In RELEASE builds, require command-line argument
+#ifdef NDEBUG
+    // Release build: require command-line argument
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (!parsed_options.count("file")) {
+      throw std::runtime_error(
+          "No assembly file specified. Use --file or -f to specify the "
+          "assembly file.");
+    }
+    program_file_path = GetFilePath(parsed_options, "file");
+#else
+    // Debug build: use sample program if no file is specified
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (!parsed_options.count("file")) {
+      program_file_path = "sample_program.s";
+      LOG_INFO("No assembly file specified, using default sample program: {}",
+               program_file_path);
+    } else {
+      program_file_path = GetFilePath(parsed_options, "file");
+    }
+#endif
+
+    const bool from_stdin = program_file_path == STANDARD_STREAM_PATH;
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (from_stdin && !parsed_options.count("output")) {
+      throw std::runtime_error(
+          "No output file specified. Use --output or -o when assembling from "
+          "stdin.");
+    }
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (from_stdin && parsed_options.count("watch")) {
+      throw std::runtime_error("Cannot watch stdin for changes.");
+    }
+
+    const bool relocatable = parsed_options.count("relocatable") > 0;
+    const bool sectioned = parsed_options.count("sectioned") > 0;
+    if (relocatable && sectioned) {
+      throw std::runtime_error(
+          "Cannot write both a relocatable object and a sectioned image.");
+    }
+    if (parsed_options.count("read-only-text") > 0 && !sectioned) {
+      throw std::runtime_error(
+          "Read-only text segments need a sectioned image (--sectioned).");
+    }
+    OutputFormat format = OutputFormat::IMAGE;
+    if (relocatable) {
+      format = OutputFormat::OBJECT;
+    } else if (sectioned) {
+      format = OutputFormat::SECTIONED;
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    const std::string output_file_path =
+        parsed_options.count("output")
+            ? GetFilePath(parsed_options, "output")
+            : std::filesystem::path(program_file_path)
+                  .replace_extension(format == OutputFormat::OBJECT ? ".o"
+                                                                    : ".bin")
+                  .string();
+
+    Assembler assembler{};
+    assembler.SetOptimization(parsed_options.count("optimize") > 0);
+    assembler.SetPositionIndependent(parsed_options.count("no-pic") == 0);
+    assembler.SetReadOnlyText(parsed_options.count("read-only-text") > 0);
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("debug-symbols")) {
+      if (format == OutputFormat::OBJECT) {
+        throw std::runtime_error(
+            "Symbol maps are only written for program images.");
+      }
+      if (output_file_path == STANDARD_STREAM_PATH) {
+        throw std::runtime_error(
+            "Cannot write a symbol map when writing the program to stdout.");
+      }
+      assembler.SetSymbolMapPath(
+          std::filesystem::path(output_file_path)
+              .replace_extension(SYMBOL_MAP_EXTENSION)
+              .string());
+    }
+
+    assembler.AssembleFile(program_file_path, output_file_path, format);
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("watch")) {
+      assembler.Watch(program_file_path, output_file_path, format);
+    }
 
-  return EXIT_SUCCESS;
+    return EXIT_SUCCESS;
+  } catch (const std::exception& e) {
+    const char* msg = "Error occurred";
+    if (Logger::GetLogger()) {
+      LOG_ERROR("{}: {}", msg, e.what());
+    } else {
+      std::cerr << "FATAL ERROR: " << msg << ": " << e.what() << '\n';
+    }
+    return EXIT_FAILURE;
+  } catch (...) {
+    const char* msg = "Unknown error occurred";
+    if (Logger::GetLogger()) {
+      LOG_ERROR("{}", msg);
+    } else {
+      std::cerr << "FATAL ERROR: " << msg << '\n';
+    }
+    return EXIT_FAILURE;
+  }
 }
@@ -0,0 +1,272 @@
+#include "dlw1_assembler/mapped_file.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#else
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#endif
+
+#ifdef MAPPED_FILE_POSIX
+[[nodiscard]] static std::runtime_error SystemError(
+    const std::string& message, const std::string& file_path) {
+  return std::runtime_error(message + ": " + file_path + ": " +
+                            std::strerror(errno));
+}
+
+// Allocates disk blocks for the first `size` bytes of a file, returning an
+// errno value. Without them, a write to a mapped page on a full disk raises
+// SIGBUS instead of failing.
+[[nodiscard]] static int ReserveBlocks(const int file_descriptor,
+                                       const std::size_t size) noexcept {
+#ifdef __APPLE__
+  static_cast<void>(file_descriptor);
+  static_cast<void>(size);
+  return ENOTSUP;
+#else
+  return posix_fallocate(file_descriptor, 0, static_cast<off_t>(size));
+#endif
+}
+#endif
+
+InputFile::InputFile(const std::string& file_path)
+    : data(nullptr), size(0), mapped(false) {
+  const bool standard_input = file_path == STANDARD_STREAM_PATH;
+
+#ifdef MAPPED_FILE_POSIX
+  const int file_descriptor =
+      standard_input ? STDIN_FILENO
+                     : open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_descriptor < 0) {
+    throw SystemError("Failed to open program file", file_path);
+  }
+
+  struct stat file_status {};
+  if (fstat(file_descriptor, &file_status) == 0 &&
+      S_ISREG(file_status.st_mode) && file_status.st_size > 0) {
+    size = static_cast<std::size_t>(file_status.st_size);
+    void* address =
+        mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (address != MAP_FAILED) {
+      // The lexer makes one front-to-back pass over the source
+      madvise(address, size, MADV_SEQUENTIAL);
+      data = static_cast<const char*>(address);
+      mapped = true;
+    }
+  }
+
+  // Pipes, terminals and filesystems without mmap support are read instead
+  if (!mapped) {
+    std::array<char, 65536> chunk{};
+    while (true) {
+      const ssize_t length = read(file_descriptor, chunk.data(), chunk.size());
+      if (length < 0 && errno == EINTR) {
+        continue;
+      }
+      if (length < 0) {
+        const std::runtime_error error =
+            SystemError("Failed to read program file", file_path);
+        if (!standard_input) {
+          close(file_descriptor);
+        }
+        throw error;
+      }
+      if (length == 0) {
+        break;
+      }
+      buffer.append(chunk.data(), static_cast<std::size_t>(length));
+    }
+    data = buffer.data();
+    size = buffer.size();
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  if (!standard_input) {
+    close(file_descriptor);
+  }
+#else
+  if (standard_input) {
+    buffer.assign(std::istreambuf_iterator<char>(std::cin),
+                  std::istreambuf_iterator<char>());
+  } else {
+    std::ifstream program_file(file_path, std::ios::binary);
+    if (!program_file) {
+      throw std::runtime_error("Failed to open program file: " + file_path);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(program_file),
+                  std::istreambuf_iterator<char>());
+  }
+  data = buffer.data();
+  size = buffer.size();
+#endif
+}
+
+InputFile::~InputFile() {
+#ifdef MAPPED_FILE_POSIX
+  if (mapped) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    munmap(const_cast<char*>(data), size);
+  }
+#endif
+}
+
+std::string_view InputFile::View() const noexcept { return {data, size}; }
+
+OutputFile::OutputFile(const std::string& file_path,
+                       const std::size_t file_size)
+    : path(file_path),
+      data(nullptr),
+      size(file_size),
+      file_descriptor(-1),
+      mapped(false) {
+#ifdef MAPPED_FILE_POSIX
+  file_descriptor =
+      path == STANDARD_STREAM_PATH
+          ? STDOUT_FILENO
+          : open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                 S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (file_descriptor < 0) {
+    throw SystemError("Failed to open output file", path);
+  }
+
+  struct stat file_status {};
+  if (size > 0 && fstat(file_descriptor, &file_status) == 0 &&
+      S_ISREG(file_status.st_mode)) {
+    if (ftruncate(file_descriptor, static_cast<off_t>(size)) != 0) {
+      const std::runtime_error error =
+          SystemError("Failed to resize output file", path);
+      Close();
+      throw error;
+    }
+
+    // Where blocks cannot be reserved the file is written from a buffer,
+    // whose write errors are reported normally
+    const int reserved = ReserveBlocks(file_descriptor, size);
+    if (reserved == ENOSPC || reserved == EDQUOT) {
+      errno = reserved;
+      const std::runtime_error error =
+          SystemError("Failed to resize output file", path);
+      Close();
+      throw error;
+    }
+
+    void* address =
+        reserved != 0 ? MAP_FAILED
+                      : mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, file_descriptor, 0);
+    if (address != MAP_FAILED) {
+      data = static_cast<uint8_t*>(address);
+      mapped = true;
+      return;
+    }
+  }
+#endif
+
+  buffer.resize(size);
+  data = buffer.data();
+}
+
+OutputFile::~OutputFile() { Close(); }
+
+void OutputFile::Close() noexcept {
+#ifdef MAPPED_FILE_POSIX
+  if (mapped) {
+    munmap(data, size);
+    mapped = false;
+  }
+  if (file_descriptor >= 0 && file_descriptor != STDOUT_FILENO) {
+    close(file_descriptor);
+  }
+  file_descriptor = -1;
+#endif
+}
+
+std::span<uint8_t> OutputFile::Data() noexcept { return {data, size}; }
+
+void OutputFile::Commit(const bool durable) {
+#ifdef MAPPED_FILE_POSIX
+  // Mapped pages are written back by the kernel once unmapped
+  if (mapped && durable && msync(data, size, MS_SYNC) != 0) {
+    throw SystemError("Failed to write output file", path);
+  }
+  if (!mapped) {
+    std::span<const uint8_t> remaining{buffer};
+    while (!remaining.empty()) {
+      const ssize_t length =
+          write(file_descriptor, remaining.data(), remaining.size());
+      if (length < 0 && errno == EINTR) {
+        continue;
+      }
+      if (length < 0) {
+        throw SystemError("Failed to write output file", path);
+      }
+      remaining = remaining.subspan(static_cast<std::size_t>(length));
+    }
+  }
+  if (durable && file_descriptor != STDOUT_FILENO &&
+      fsync(file_descriptor) != 0) {
+    throw SystemError("Failed to write output file", path);
+  }
+  Close();
+#else
+  std::ofstream output_file;
+  std::ostream* output = &std::cout;
+  if (path != STANDARD_STREAM_PATH) {
+    output_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!output_file) {
+      throw std::runtime_error("Failed to open output file: " + path);
+    }
+    output = &output_file;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  output->write(reinterpret_cast<const char*>(buffer.data()),
+                static_cast<std::streamsize>(buffer.size()));
+  output->flush();
+  if (!*output) {
+    throw std::runtime_error("Failed to write output file: " + path);
+  }
+  static_cast<void>(durable);
+#endif
+}
+
+void SyncDirectoryEntry(const std::string& file_path) {
+#ifdef MAPPED_FILE_POSIX
+  std::string directory = file_path.substr(0, file_path.find_last_of('/'));
+  if (directory.size() == file_path.size()) {
+    directory = ".";
+  } else if (directory.empty()) {
+    directory = "/";
+  }
+
+  const int directory_descriptor =
+      open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (directory_descriptor < 0) {
+    throw SystemError("Failed to open directory", directory);
+  }
+  const int result = fsync(directory_descriptor);
+  const int sync_error = errno;
+  close(directory_descriptor);
+  if (result != 0) {
+    errno = sync_error;
+    throw SystemError("Failed to sync directory", directory);
+  }
+#else
+  static_cast<void>(file_path);
+#endif
+}
@@ -0,0 +1,202 @@
+#include "dlw1_assembler/object_file.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static constexpr std::size_t HEADER_SIZE = 4 + 1 + 4 + 4 + 2 + 2;
+static constexpr std::size_t SYMBOL_SIZE = 1 + 1 + 1 + 2;  // Without name
+static constexpr std::size_t RELOCATION_SIZE = 1 + 2 + 1 + 2;
+
+// Sequential big-endian writer over a pre-sized buffer
+class ObjectWriter {
+ private:
+  std::span<uint8_t> bytes;
+  std::size_t position = 0;
+
+ public:
+  explicit ObjectWriter(const std::span<uint8_t> bytes) : bytes(bytes) {}
+
+  void U8(const uint8_t value) { bytes[position++] = value; }
+  void U16(const uint16_t value) {
+    U8(static_cast<uint8_t>(value >> 8U));
+    U8(static_cast<uint8_t>(value));
+  }
+  void U32(const uint32_t value) {
+    U16(static_cast<uint16_t>(value >> 16U));
+    U16(static_cast<uint16_t>(value));
+  }
+  void Bytes(const std::span<const uint8_t> data) {
+    std::ranges::copy(data, bytes.subspan(position).begin());
+    position += data.size();
+  }
+};
+
+// Sequential big-endian reader that rejects reads past the end
+class ObjectReader {
+ private:
+  std::span<const uint8_t> bytes;
+  std::size_t position = 0;
+
+ public:
+  explicit ObjectReader(const std::span<const uint8_t> bytes) : bytes(bytes) {}
+
+  [[nodiscard]] std::span<const uint8_t> Bytes(const std::size_t count) {
+    if (count > bytes.size() - position) {
+      throw std::runtime_error("Truncated object file");
+    }
+    const std::span<const uint8_t> data = bytes.subspan(position, count);
+    position += count;
+    return data;
+  }
+  [[nodiscard]] uint8_t U8() { return Bytes(1)[0]; }
+  [[nodiscard]] uint16_t U16() {
+    const std::span<const uint8_t> data = Bytes(2);
+    return static_cast<uint16_t>((data[0] << 8U) | data[1]);
+  }
+  [[nodiscard]] uint32_t U32() {
+    const uint32_t high = U16();
+    return (high << 16U) | U16();
+  }
+  [[nodiscard]] bool AtEnd() const noexcept {
+    return position == bytes.size();
+  }
+};
+
+std::vector<uint8_t>& ObjectFile::Contents(const Section section) noexcept {
+  return sections[static_cast<std::size_t>(section)];
+}
+
+const std::vector<uint8_t>& ObjectFile::Contents(
+    const Section section) const noexcept {
+  return sections[static_cast<std::size_t>(section)];
+}
+
+std::size_t ObjectFile::SerializedSize() const noexcept {
+  std::size_t size = HEADER_SIZE + Contents(Section::TEXT).size() +
+                     Contents(Section::DATA).size() +
+                     relocations.size() * RELOCATION_SIZE;
+  for (const ObjectSymbol& symbol : symbols) {
+    size += SYMBOL_SIZE + symbol.name.size();
+  }
+  return size;
+}
+
+void ObjectFile::Serialize(const std::span<uint8_t> bytes) const {
+  if (bytes.size() != SerializedSize()) {
+    throw std::runtime_error("Object file buffer has the wrong size");
+  }
+
+  ObjectWriter writer{bytes};
+  writer.Bytes(MAGIC);
+  writer.U8(VERSION);
+  writer.U32(static_cast<uint32_t>(Contents(Section::TEXT).size()));
+  writer.U32(static_cast<uint32_t>(Contents(Section::DATA).size()));
+  writer.U16(static_cast<uint16_t>(symbols.size()));
+  writer.U16(static_cast<uint16_t>(relocations.size()));
+  writer.Bytes(Contents(Section::TEXT));
+  writer.Bytes(Contents(Section::DATA));
+
+  for (const ObjectSymbol& symbol : symbols) {
+    if (symbol.name.size() > UINT8_MAX) {
+      throw std::runtime_error("Symbol name too long: " + symbol.name);
+    }
+    writer.U8(static_cast<uint8_t>(symbol.name.size()));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    writer.Bytes({reinterpret_cast<const uint8_t*>(symbol.name.data()),
+                  symbol.name.size()});
+    writer.U8(static_cast<uint8_t>(symbol.binding));
+    writer.U8(static_cast<uint8_t>(symbol.section));
+    writer.U16(symbol.offset);
+  }
+
+  for (const Relocation& relocation : relocations) {
+    writer.U8(static_cast<uint8_t>(relocation.section));
+    writer.U16(relocation.offset);
+    writer.U8(static_cast<uint8_t>(relocation.type));
+    writer.U16(relocation.symbol);
+  }
+}
+
+ObjectFile ObjectFile::Deserialize(const std::span<const uint8_t> bytes) {
+  if (!IsObject(bytes)) {
+    throw std::runtime_error("Not a DLW-1 object file");
+  }
+
+  ObjectReader reader{bytes};
+  static_cast<void>(reader.Bytes(MAGIC.size()));
+  if (const uint8_t version = reader.U8(); version != VERSION) {
+    throw std::runtime_error("Unsupported object file version " +
+                             std::to_string(version));
+  }
+
+  ObjectFile object;
+  const uint32_t text_size = reader.U32();
+  const uint32_t data_size = reader.U32();
+  const uint16_t symbol_count = reader.U16();
+  const uint16_t relocation_count = reader.U16();
+
+  const std::span<const uint8_t> text = reader.Bytes(text_size);
+  object.Contents(Section::TEXT).assign(text.begin(), text.end());
+  const std::span<const uint8_t> data = reader.Bytes(data_size);
+  object.Contents(Section::DATA).assign(data.begin(), data.end());
+
+  const auto read_section = [&reader] {
+    const uint8_t section = reader.U8();
+    if (section >= SECTION_COUNT) {
+      throw std::runtime_error("Invalid section " + std::to_string(section) +
+                               " in object file");
+    }
+    return static_cast<Section>(section);
+  };
+
+  object.symbols.reserve(symbol_count);
+  for (uint16_t i = 0; i < symbol_count; ++i) {
+    ObjectSymbol& symbol = object.symbols.emplace_back();
+    const std::span<const uint8_t> name = reader.Bytes(reader.U8());
+    symbol.name.assign(name.begin(), name.end());
+    const uint8_t binding = reader.U8();
+    if (binding > static_cast<uint8_t>(SymbolBinding::EXTERN)) {
+      throw std::runtime_error("Invalid binding for symbol '" + symbol.name +
+                               "' in object file");
+    }
+    symbol.binding = static_cast<SymbolBinding>(binding);
+    symbol.section = read_section();
+    symbol.offset = reader.U16();
+  }
+
+  object.relocations.reserve(relocation_count);
+  for (uint16_t i = 0; i < relocation_count; ++i) {
+    Relocation& relocation = object.relocations.emplace_back();
+    relocation.section = read_section();
+    relocation.offset = reader.U16();
+    const uint8_t type = reader.U8();
+    if (type > static_cast<uint8_t>(RelocationType::RELATIVE_9)) {
+      throw std::runtime_error("Invalid relocation type in object file");
+    }
+    relocation.type = static_cast<RelocationType>(type);
+    relocation.symbol = reader.U16();
+    if (relocation.symbol >= symbol_count ||
+        relocation.offset + 2U > object.Contents(relocation.section).size()) {
+      throw std::runtime_error("Invalid relocation in object file");
+    }
+  }
+
+  if (!reader.AtEnd()) {
+    throw std::runtime_error("Trailing data in object file");
+  }
+  return object;
+}
+
+bool ObjectFile::IsObject(const std::span<const uint8_t> bytes) noexcept {
+  return bytes.size() >= MAGIC.size() &&
+         std::ranges::equal(bytes.first(MAGIC.size()), MAGIC);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -0,0 +1,282 @@
+#include "dlw1_assembler/optimizer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "dlw1_assembler/statement.hpp"
+#include "dlw1_assembler/token.hpp"
+
+[[nodiscard]] static Operand RegisterOperand(const uint8_t reg) {
+  return {.type = OperandType::REGISTER, .reg = reg};
+}
+
+[[nodiscard]] static bool IsAlu(const Statement& statement) noexcept {
+  return statement.keyword == TokenType::ADD ||
+         statement.keyword == TokenType::SUB;
+}
+
+// add/sub with a plain number (not a label address) as second operand
+[[nodiscard]] static bool IsAluImmediate(const Statement& statement) noexcept {
+  return IsAlu(statement) &&
+         statement.operands[1].type == OperandType::IMMEDIATE &&
+         statement.operands[1].symbol.empty();
+}
+
+// Signed amount an add/sub immediate adds to its source register
+[[nodiscard]] static int32_t AluAddend(const Statement& statement) noexcept {
+  const int32_t value = statement.operands[1].value;
+  return statement.keyword == TokenType::SUB ? -value : value;
+}
+
+[[nodiscard]] static bool IsImmediateAccess(const Statement& statement,
+                                            const TokenType keyword) noexcept {
+  return statement.keyword == keyword &&
+         statement.operands[1].type == OperandType::IMMEDIATE;
+}
+
+[[nodiscard]] static Statement Mov(const Statement& original,
+                                   const uint8_t src, const uint8_t dest) {
+  return {.label = original.label,
+          .type = StatementType::INSTRUCTION,
+          .keyword = TokenType::MOV,
+          .operands = {RegisterOperand(src), RegisterOperand(dest)},
+          .line_number = original.line_number};
+}
+
+// Bank switches continue at the next address of another bank, and .org
+// places code at a fixed address, so nothing before either may move
+[[nodiscard]] static bool FixesLayout(const Statement& statement) noexcept {
+  return statement.keyword == TokenType::BANK ||
+         statement.keyword == TokenType::DIRECTIVE_ORG;
+}
+
+Optimizer::Optimizer(const std::span<const Statement* const> program)
+    : program(program), current(program.begin(), program.end()) {
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    if (FixesLayout(*program[i])) {
+      fixed_layout_end = i + 1;
+    }
+  }
+}
+
+const Statement& Optimizer::At(const std::size_t index) const {
+  return *current[index];
+}
+
+// Index of the instruction executed right after `index` when no other path
+// can enter in between, or the program size if there is none
+std::size_t Optimizer::NextInstruction(const std::size_t index) const {
+  for (std::size_t next = index + 1; next < current.size(); ++next) {
+    const Statement& statement = At(next);
+    if (!statement.label.empty()) {
+      break;
+    }
+    if (statement.type == StatementType::INSTRUCTION) {
+      return next;
+    }
+    if (statement.type == StatementType::DIRECTIVE) {
+      break;
+    }
+  }
+  return current.size();
+}
+
+// Whether any instruction reachable after `index` can read its PSW result.
+// Jumps are assumed to read it, as their targets are not followed.
+bool Optimizer::FlagsLiveAfter(const std::size_t index) const {
+  for (std::size_t next = index + 1; next < current.size(); ++next) {
+    const Statement& statement = At(next);
+    if (statement.type == StatementType::DIRECTIVE) {
+      if (statement.keyword == TokenType::DIRECTIVE_GLOBAL ||
+          statement.keyword == TokenType::DIRECTIVE_EXTERN) {
+        continue;
+      }
+      return true;  // Execution may run into data or jump elsewhere
+    }
+    if (statement.type != StatementType::INSTRUCTION) {
+      continue;
+    }
+
+    switch (statement.keyword) {
+      case TokenType::ADD:
+      case TokenType::SUB:
+      case TokenType::HALT:
+        return false;
+      case TokenType::BANK:  // Execution continues in unknown code
+      case TokenType::JUMP:
+      case TokenType::JUMPZ:
+      case TokenType::JUMPNZ:
+      case TokenType::JUMPN:
+        return true;
+      default:
+        break;
+    }
+  }
+  // Running off the end falls into whatever follows in memory, which
+  // may be data or the next bank's code
+  return true;
+}
+
+bool Optimizer::Removable(const std::size_t index) const noexcept {
+  return index >= fixed_layout_end;
+}
+
+void Optimizer::Replace(const std::size_t index, Statement statement) {
+  current[index] = &replacements.emplace_back(std::move(statement));
+}
+
+void Optimizer::Remove(const std::size_t index) {
+  const Statement& statement = At(index);
+  Replace(index, {.label = statement.label,
+                  .type = StatementType::EMPTY,
+                  .line_number = statement.line_number});
+  ++eliminated;
+}
+
+bool Optimizer::RewriteSingle(const std::size_t index) {
+  const Statement& statement = At(index);
+  const std::vector<Operand>& operands = statement.operands;
+
+  if (statement.keyword == TokenType::MOV &&
+      operands[0].reg == operands[1].reg && Removable(index)) {
+    Remove(index);
+    return true;
+  }
+
+  if (IsAluImmediate(statement) &&
+      static_cast<uint8_t>(operands[1].value) == 0 &&
+      (operands[0].reg != operands[2].reg || Removable(index)) &&
+      !FlagsLiveAfter(index)) {
+    if (operands[0].reg == operands[2].reg) {
+      Remove(index);
+    } else {
+      Replace(index, Mov(statement, operands[0].reg, operands[2].reg));
+    }
+    return true;
+  }
+
+  return false;
+}
+
+bool Optimizer::RewritePair(const std::size_t first, const std::size_t second) {
+  const Statement& lhs = At(first);
+  const Statement& rhs = At(second);
+
+  // Loading what was just stored reuses the stored register
+  if (IsImmediateAccess(lhs, TokenType::STORE) &&
+      IsImmediateAccess(rhs, TokenType::LOAD) &&
+      lhs.operands[1] == rhs.operands[1] &&
+      (lhs.operands[0].reg != rhs.operands[0].reg || Removable(second))) {
+    if (lhs.operands[0].reg == rhs.operands[0].reg) {
+      Remove(second);
+    } else {
+      Replace(second, Mov(rhs, lhs.operands[0].reg, rhs.operands[0].reg));
+    }
+    return true;
+  }
+
+  // A store overwritten by the next instruction is never observed
+  if (IsImmediateAccess(lhs, TokenType::STORE) &&
+      IsImmediateAccess(rhs, TokenType::STORE) &&
+      lhs.operands[1] == rhs.operands[1] && Removable(first)) {
+    Remove(first);
+    return true;
+  }
+
+  // Storing what was just loaded leaves memory unchanged
+  if (IsImmediateAccess(lhs, TokenType::LOAD) &&
+      IsImmediateAccess(rhs, TokenType::STORE) &&
+      lhs.operands[1] == rhs.operands[1] &&
+      lhs.operands[0].reg == rhs.operands[0].reg && Removable(second)) {
+    Remove(second);
+    return true;
+  }
+
+  // Registers wrap modulo 256 and the PSW only reflects the final result, so
+  // two chained immediates fold into one
+  const uint8_t dest = lhs.operands.empty() ? 0 : lhs.operands.back().reg;
+  if (IsAluImmediate(lhs) && IsAluImmediate(rhs) &&
+      rhs.operands[0].reg == dest && rhs.operands[2].reg == dest &&
+      Removable(second)) {
+    const auto sum = static_cast<int8_t>(
+        static_cast<uint8_t>(AluAddend(lhs) + AluAddend(rhs)));
+    Replace(first, {.label = lhs.label,
+                    .type = StatementType::INSTRUCTION,
+                    .keyword = TokenType::ADD,
+                    .operands = {lhs.operands[0],
+                                 {.type = OperandType::IMMEDIATE, .value = sum},
+                                 lhs.operands[2]},
+                    .line_number = lhs.line_number});
+    Remove(second);
+    return true;
+  }
+
+  return false;
+}
+
+// Numeric jump targets and load/store addresses hold addresses the optimizer
+// cannot update once instructions move. So may registers used as addresses,
+// as numeric immediates can have been added into them.
+bool Optimizer::DependsOnLayout(const Statement& statement) {
+  switch (statement.keyword) {
+    case TokenType::JUMP:
+    case TokenType::JUMPZ:
+    case TokenType::JUMPNZ:
+    case TokenType::JUMPN:
+      return statement.operands[0].symbol.empty();
+    case TokenType::LOAD:
+    case TokenType::STORE:
+      return statement.operands[1].type != OperandType::IMMEDIATE ||
+             statement.operands[1].symbol.empty();
+    default:
+      return false;
+  }
+}
+
+OptimizationResult Optimizer::Optimize(
+    const std::span<const Statement* const> program) {
+  OptimizationResult result;
+  Optimizer optimizer{program};
+  // Rewrites that keep the size still apply, as nothing moves
+  for (const Statement* statement : program) {
+    if (statement->type == StatementType::INSTRUCTION &&
+        DependsOnLayout(*statement)) {
+      result.numeric_addresses = true;
+      optimizer.fixed_layout_end = program.size();
+      break;
+    }
+  }
+
+  // Every rewrite removes an instruction or turns one into a mov that no
+  // pattern matches again, so the passes terminate
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (std::size_t i = 0; i < program.size(); ++i) {
+      if (optimizer.At(i).type != StatementType::INSTRUCTION) {
+        continue;
+      }
+      if (optimizer.RewriteSingle(i)) {
+        changed = true;
+        if (optimizer.At(i).type != StatementType::INSTRUCTION) {
+          continue;
+        }
+      }
+
+      const std::size_t next = optimizer.NextInstruction(i);
+      if (next < program.size() && optimizer.RewritePair(i, next)) {
+        changed = true;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    if (optimizer.current[i] != program[i]) {
+      result.rewrites.emplace_back(i, optimizer.At(i));
+    }
+  }
+  result.eliminated_instructions = optimizer.eliminated;
+  return result;
+}
@@ -0,0 +1,370 @@
+#include "dlw1_assembler/parser.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "dlw1_assembler/statement.hpp"
+#include "dlw1_assembler/token.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+bool Parser::EndOfLine() const noexcept { return position >= tokens.size(); }
+
+const Token& Parser::Peek() const noexcept {
+  static const Token end_of_line{.text = "end of line",
+                                 .type = TokenType::END_OF_FILE,
+                                 .line_number = 0};
+  return EndOfLine() ? end_of_line : tokens[position];
+}
+
+const Token& Parser::Get() noexcept {
+  const Token& token = Peek();
+  if (!EndOfLine()) {
+    ++position;
+  }
+  return token;
+}
+
+bool Parser::Accept(const TokenType type) noexcept {
+  if (!EndOfLine() && Peek().type == type) {
+    ++position;
+    return true;
+  }
+  return false;
+}
+
+const Token& Parser::Expect(const TokenType type,
+                            const std::string_view description) {
+  if (EndOfLine() || Peek().type != type) {
+    Error("Expected " + std::string(description) + ", found '" +
+          Peek().text + "'");
+  }
+  return Get();
+}
+
+void Parser::Error(const std::string& message) const {
+  throw std::runtime_error("Line " + std::to_string(line_number + 1) + ": " +
+                           message);
+}
+
+void Parser::CheckRange(const int32_t value, const int32_t min,
+                        const int32_t max,
+                        const std::string_view description) const {
+  if (value < min || value > max) {
+    Error(std::string(description) + " " + std::to_string(value) +
+          " out of range [" + std::to_string(min) + ", " +
+          std::to_string(max) + "]");
+  }
+}
+
+int32_t Parser::ParseSignedNumber() {
+  bool negative = false;
+  if (Accept(TokenType::MINUS)) {
+    negative = true;
+  } else {
+    static_cast<void>(Accept(TokenType::PLUS));
+  }
+
+  const int32_t value =
+      ParseNumber(Expect(TokenType::NUMBER, "a number").text, line_number);
+  return negative ? -value : value;
+}
+
+Operand Parser::ParseOperand() {
+  const Token& token = Peek();
+  switch (token.type) {
+    case TokenType::REGISTER:
+      return {.type = OperandType::REGISTER,
+              .reg = ParseRegister(Get().text)};
+    case TokenType::HASH:
+      static_cast<void>(Get());
+      if (Peek().type == TokenType::IDENTIFIER) {
+        return {.type = OperandType::IMMEDIATE, .symbol = Get().text};
+      }
+      return {.type = OperandType::IMMEDIATE, .value = ParseSignedNumber()};
+    case TokenType::LPARENTHESES: {
+      static_cast<void>(Get());
+      Operand operand{.type = OperandType::RELATIVE};
+      if (Peek().type == TokenType::REGISTER) {
+        operand.reg = ParseRegister(Get().text);
+      }
+
+      bool negative = false;
+      if (Accept(TokenType::MINUS)) {
+        negative = true;
+      } else if (!Accept(TokenType::PLUS)) {
+        Error("Expected '+' or '-' before offset, found '" + Peek().text +
+              "'");
+      }
+      Expect(TokenType::HASH, "'#'");
+      const int32_t offset = ParseNumber(
+          Expect(TokenType::NUMBER, "an offset").text, line_number);
+      operand.value = negative ? -offset : offset;
+
+      Expect(TokenType::RPARENTHESES, "')'");
+      return operand;
+    }
+    case TokenType::IDENTIFIER:
+      return {.type = OperandType::SYMBOL, .symbol = Get().text};
+    case TokenType::MINUS:
+    case TokenType::NUMBER:
+    case TokenType::PLUS:
+      return {.type = OperandType::NUMBER, .value = ParseSignedNumber()};
+    default:
+      Error("Unexpected '" + token.text + "'");
+  }
+}
+
+void Parser::ValidateDirective(const Statement& statement) const {
+  const std::vector<Operand>& operands = statement.operands;
+
+  // Symbol declarations name labels, every other directive takes numbers
+  if (statement.keyword == TokenType::DIRECTIVE_EXTERN ||
+      statement.keyword == TokenType::DIRECTIVE_GLOBAL) {
+    if (operands.empty()) {
+      Error("Symbol declarations expect at least one label");
+    }
+    for (const Operand& operand : operands) {
+      if (operand.type != OperandType::SYMBOL) {
+        Error("Symbol declarations expect label names");
+      }
+    }
+    return;
+  }
+
+  for (const Operand& operand : operands) {
+    if (operand.type != OperandType::NUMBER) {
+      Error("Directive arguments must be numbers");
+    }
+  }
+
+  switch (statement.keyword) {
+    case TokenType::DIRECTIVE_ORG:
+      if (operands.size() != 1) {
+        Error(".org expects a single address");
+      }
+      CheckRange(operands[0].value, 0, 0xFFFF, "Origin");
+      break;
+    case TokenType::DIRECTIVE_BYTE:
+    case TokenType::DIRECTIVE_WORD: {
+      const bool is_byte = statement.keyword == TokenType::DIRECTIVE_BYTE;
+      if (operands.empty()) {
+        Error(std::string(is_byte ? ".byte" : ".word") +
+              " expects at least one value");
+      }
+      for (const Operand& operand : operands) {
+        if (is_byte) {
+          CheckRange(operand.value, -0x80, 0xFF, "Byte");
+        } else {
+          CheckRange(operand.value, -0x8000, 0xFFFF, "Word");
+        }
+      }
+      break;
+    }
+    case TokenType::DIRECTIVE_DATA:
+    case TokenType::DIRECTIVE_TEXT:
+      if (!operands.empty()) {
+        Error("Section directives take no arguments");
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void Parser::ValidateInstruction(const Statement& statement) const {
+  const std::vector<Operand>& operands = statement.operands;
+  const auto is = [&operands](const std::size_t index,
+                              const OperandType type) {
+    return operands[index].type == type;
+  };
+
+  std::ostringstream mnemonic;
+  mnemonic << statement.keyword;
+
+  switch (statement.keyword) {
+    case TokenType::ADD:
+    case TokenType::SUB:
+      if (operands.size() != 3 || !is(0, OperandType::REGISTER) ||
+          !(is(1, OperandType::REGISTER) || is(1, OperandType::IMMEDIATE)) ||
+          !is(2, OperandType::REGISTER)) {
+        Error(mnemonic.str() +
+              " expects 'src, src2, dest' or 'src, #imm, dest'");
+      }
+      if (is(1, OperandType::IMMEDIATE)) {
+        CheckRange(operands[1].value, -0x80, 0xFF, "Immediate");
+      }
+      break;
+    case TokenType::LOAD:
+    case TokenType::STORE:
+      if (operands.size() != 2 || !is(0, OperandType::REGISTER) ||
+          !(is(1, OperandType::IMMEDIATE) || is(1, OperandType::REGISTER) ||
+            is(1, OperandType::RELATIVE))) {
+        Error(mnemonic.str() +
+              " expects 'reg, #addr', 'reg, reg' or 'reg, (base +/- #imm)'");
+      }
+      if (is(1, OperandType::IMMEDIATE)) {
+        CheckRange(operands[1].value, 0, 0xFF, "Address");
+      } else if (is(1, OperandType::RELATIVE)) {
+        if (operands[1].reg == Operand::NO_REGISTER) {
+          Error("Relative addressing requires a base register");
+        }
+        // A zero base field selects the immediate form
+        if (operands[1].reg == 0) {
+          Error("Register ra cannot be used as a base register");
+        }
+        CheckRange(operands[1].value, -0x80, 0x7F, "Offset");
+      }
+      break;
+    case TokenType::MOV:
+      if (operands.size() != 2 || !is(0, OperandType::REGISTER) ||
+          !is(1, OperandType::REGISTER)) {
+        Error(mnemonic.str() + " expects 'src, dest'");
+      }
+      break;
+    case TokenType::BANK:
+      if (operands.size() != 1 || !is(0, OperandType::IMMEDIATE) ||
+          !operands[0].symbol.empty()) {
+        Error(mnemonic.str() + " expects '#bank'");
+      }
+      CheckRange(operands[0].value, 0, 0xFF, "Bank");
+      break;
+    case TokenType::JUMP:
+    case TokenType::JUMPZ:
+    case TokenType::JUMPNZ:
+    case TokenType::JUMPN:
+      if (operands.size() != 1 || is(0, OperandType::NUMBER) ||
+          (is(0, OperandType::RELATIVE) &&
+           operands[0].reg != Operand::NO_REGISTER)) {
+        Error(mnemonic.str() +
+              " expects '#addr', 'label', 'reg' or '(+/- #offset)'");
+      }
+      if (is(0, OperandType::IMMEDIATE)) {
+        CheckRange(operands[0].value, 0, 0xFF, "Address");
+      } else if (is(0, OperandType::RELATIVE)) {
+        CheckRange(operands[0].value, -0x100, 0xFF, "Offset");
+      }
+      break;
+    case TokenType::HALT:
+      if (!operands.empty()) {
+        Error(mnemonic.str() + " takes no operands");
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+Statement Parser::Parse() {
+  Statement statement{.line_number = line_number};
+  if (EndOfLine()) {
+    return statement;
+  }
+
+  // Label definition
+  if (Peek().type == TokenType::IDENTIFIER) {
+    const Token& identifier = Get();
+    if (!Accept(TokenType::COLON)) {
+      Error("Unknown mnemonic '" + identifier.text + "'");
+    }
+    statement.label = identifier.text;
+    if (EndOfLine()) {
+      return statement;
+    }
+  }
+
+  const Token& keyword = Get();
+  statement.keyword = keyword.type;
+  switch (keyword.type) {
+    case TokenType::ADD:
+    case TokenType::BANK:
+    case TokenType::HALT:
+    case TokenType::JUMP:
+    case TokenType::JUMPN:
+    case TokenType::JUMPNZ:
+    case TokenType::JUMPZ:
+    case TokenType::LOAD:
+    case TokenType::MOV:
+    case TokenType::STORE:
+    case TokenType::SUB:
+      statement.type = StatementType::INSTRUCTION;
+      break;
+    case TokenType::DIRECTIVE_BYTE:
+    case TokenType::DIRECTIVE_DATA:
+    case TokenType::DIRECTIVE_EXTERN:
+    case TokenType::DIRECTIVE_GLOBAL:
+    case TokenType::DIRECTIVE_ORG:
+    case TokenType::DIRECTIVE_TEXT:
+    case TokenType::DIRECTIVE_WORD:
+      statement.type = StatementType::DIRECTIVE;
+      break;
+    case TokenType::DIRECTIVE:
+      Error("Unknown directive '" + keyword.text + "'");
+    default:
+      Error("Expected a mnemonic or directive, found '" + keyword.text + "'");
+  }
+
+  if (!EndOfLine()) {
+    statement.operands.push_back(ParseOperand());
+    while (Accept(TokenType::COMMA)) {
+      statement.operands.push_back(ParseOperand());
+    }
+  }
+  if (!EndOfLine()) {
+    Error("Unexpected '" + Peek().text + "'");
+  }
+
+  if (statement.type == StatementType::INSTRUCTION) {
+    ValidateInstruction(statement);
+  } else {
+    ValidateDirective(statement);
+  }
+
+  return statement;
+}
+
+Statement Parser::ParseLine(const std::span<const Token> tokens,
+                            const std::size_t line_number) {
+  Parser parser{tokens, line_number};
+  return parser.Parse();
+}
+
+int32_t Parser::ParseNumber(const std::string_view text,
+                            const std::size_t line_number) {
+  int base = 10;
+  std::string_view digits = text;
+  if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+    base = 16;
+    digits.remove_prefix(2);
+  } else if (text.size() > 2 && text[0] == '0' &&
+             (text[1] == 'b' || text[1] == 'B')) {
+    base = 2;
+    digits.remove_prefix(2);
+  }
+
+  int32_t value = 0;
+  const auto [end, error] =
+      std::from_chars(digits.data(), digits.data() + digits.size(), value,
+                      base);
+  if (error != std::errc{} || end != digits.data() + digits.size()) {
+    throw std::runtime_error("Line " + std::to_string(line_number + 1) +
+                             ": Invalid number '" + std::string(text) + "'");
+  }
+  return value;
+}
+
+uint8_t Parser::ParseRegister(const std::string_view text) noexcept {
+  // Register names are validated by the lexer: 'r' followed by a-d
+  return static_cast<uint8_t>((static_cast<unsigned char>(text[1]) | 0x20U) -
+                              'a');
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
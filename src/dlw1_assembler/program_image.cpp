@@ -0,0 +1,140 @@
+#include "dlw1_assembler/program_image.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static constexpr std::size_t CHECKSUM_OFFSET = 4 + 1 + 2 + 2;
+
+[[nodiscard]] static uint32_t Adler32(const std::span<const uint8_t> bytes) {
+  constexpr uint32_t MODULUS = 65521;
+  // Largest run whose sums cannot overflow before the modulo
+  constexpr std::size_t RUN_SIZE = 5552;
+  uint32_t low = 1;
+  uint32_t high = 0;
+  for (std::size_t start = 0; start < bytes.size(); start += RUN_SIZE) {
+    for (const uint8_t byte : bytes.subspan(
+             start, std::min(RUN_SIZE, bytes.size() - start))) {
+      low += byte;
+      high += low;
+    }
+    low %= MODULUS;
+    high %= MODULUS;
+  }
+  return (high << 16U) | low;
+}
+
+static void Put16(const std::span<uint8_t> bytes, const std::size_t position,
+                  const uint16_t value) {
+  bytes[position] = static_cast<uint8_t>(value >> 8U);
+  bytes[position + 1] = static_cast<uint8_t>(value);
+}
+
+static void Put32(const std::span<uint8_t> bytes, const std::size_t position,
+                  const uint32_t value) {
+  Put16(bytes, position, static_cast<uint16_t>(value >> 16U));
+  Put16(bytes, position + 2, static_cast<uint16_t>(value));
+}
+
+[[nodiscard]] static uint16_t Get16(const std::span<const uint8_t> bytes,
+                                    const std::size_t position) {
+  return static_cast<uint16_t>((bytes[position] << 8U) | bytes[position + 1]);
+}
+
+[[nodiscard]] static uint32_t Get32(const std::span<const uint8_t> bytes,
+                                    const std::size_t position) {
+  return (static_cast<uint32_t>(Get16(bytes, position)) << 16U) |
+         Get16(bytes, position + 2);
+}
+
+std::size_t ProgramImage::SerializedSize() const noexcept {
+  std::size_t size = HEADER_SIZE + (segments.size() * SEGMENT_SIZE);
+  for (const ImageSegment& segment : segments) {
+    size += segment.bytes.size();
+  }
+  return size;
+}
+
+void ProgramImage::Serialize(const std::span<uint8_t> bytes) const {
+  if (segments.size() > UINT16_MAX) {
+    throw std::runtime_error("Too many segments for a program image");
+  }
+
+  std::ranges::copy(MAGIC, bytes.begin());
+  bytes[4] = VERSION;
+  Put16(bytes, 5, entry);
+  Put16(bytes, 7, static_cast<uint16_t>(segments.size()));
+
+  std::size_t table = HEADER_SIZE;
+  std::size_t contents = HEADER_SIZE + (segments.size() * SEGMENT_SIZE);
+  for (const ImageSegment& segment : segments) {
+    Put16(bytes, table, segment.address);
+    Put32(bytes, table + 2, static_cast<uint32_t>(segment.bytes.size()));
+    bytes[table + 6] = segment.flags;
+    table += SEGMENT_SIZE;
+
+    std::ranges::copy(segment.bytes, bytes.subspan(contents).begin());
+    contents += segment.bytes.size();
+  }
+
+  Put32(bytes, CHECKSUM_OFFSET, Adler32(bytes.subspan(HEADER_SIZE)));
+}
+
+ProgramImage ProgramImage::Deserialize(const std::span<const uint8_t> bytes) {
+  if (!IsImage(bytes) || bytes.size() < HEADER_SIZE) {
+    throw std::runtime_error("Not a DLW-1 program image");
+  }
+  if (const uint8_t version = bytes[4]; version != VERSION) {
+    throw std::runtime_error("Unsupported program image version " +
+                             std::to_string(version));
+  }
+  if (Get32(bytes, CHECKSUM_OFFSET) != Adler32(bytes.subspan(HEADER_SIZE))) {
+    throw std::runtime_error("Program image checksum mismatch");
+  }
+
+  ProgramImage image;
+  image.entry = Get16(bytes, 5);
+  const uint16_t segment_count = Get16(bytes, 7);
+
+  std::size_t contents = HEADER_SIZE + (segment_count * SEGMENT_SIZE);
+  if (contents > bytes.size()) {
+    throw std::runtime_error("Truncated program image");
+  }
+
+  image.segments.reserve(segment_count);
+  for (uint16_t i = 0; i < segment_count; ++i) {
+    const std::size_t table = HEADER_SIZE + (i * SEGMENT_SIZE);
+    ImageSegment& segment = image.segments.emplace_back();
+    segment.address = Get16(bytes, table);
+    const uint32_t length = Get32(bytes, table + 2);
+    segment.flags = bytes[table + 6];
+
+    if (segment.address + std::size_t{length} > ADDRESS_SPACE) {
+      throw std::runtime_error("Program image segment at address " +
+                               std::to_string(segment.address) +
+                               " exceeds the 64KB address space");
+    }
+    if (length > bytes.size() - contents) {
+      throw std::runtime_error("Truncated program image");
+    }
+    segment.bytes = bytes.subspan(contents, length);
+    contents += length;
+  }
+
+  if (contents != bytes.size()) {
+    throw std::runtime_error("Trailing bytes after program image");
+  }
+  return image;
+}
+
+bool ProgramImage::IsImage(const std::span<const uint8_t> bytes) noexcept {
+  return bytes.size() >= MAGIC.size() &&
+         std::ranges::equal(bytes.first(MAGIC.size()), MAGIC);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -0,0 +1,228 @@
+#include "dlw1_assembler/symbol_map.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dlw1_assembler/mapped_file.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static constexpr std::size_t HEADER_SIZE = 4 + 1 + 4 + 4;
+static constexpr std::size_t LINE_SIZE = 2 + 2 + 4 + 4 + 4 + 4;
+
+static void Put16(const std::span<uint8_t> bytes, const std::size_t position,
+                  const uint16_t value) {
+  bytes[position] = static_cast<uint8_t>(value >> 8U);
+  bytes[position + 1] = static_cast<uint8_t>(value);
+}
+
+static void Put32(const std::span<uint8_t> bytes, const std::size_t position,
+                  const uint32_t value) {
+  Put16(bytes, position, static_cast<uint16_t>(value >> 16U));
+  Put16(bytes, position + 2, static_cast<uint16_t>(value));
+}
+
+[[nodiscard]] static uint16_t Get16(const std::span<const uint8_t> bytes,
+                                    const std::size_t position) noexcept {
+  return static_cast<uint16_t>((bytes[position] << 8U) | bytes[position + 1]);
+}
+
+[[nodiscard]] static uint32_t Get32(const std::span<const uint8_t> bytes,
+                                    const std::size_t position) noexcept {
+  return (uint32_t{Get16(bytes, position)} << 16U) | Get16(bytes, position + 2);
+}
+
+// Deduplicating string table, laid out in insertion order
+class StringTable {
+ private:
+  std::vector<const std::string*> strings;
+  std::unordered_map<std::string_view, uint32_t> offsets;
+  uint32_t size = 0;
+
+ public:
+  uint32_t Add(const std::string& text) {
+    if (text.size() > UINT16_MAX) {
+      throw std::runtime_error("Debug string too long: " + text);
+    }
+    const auto [it, inserted] = offsets.try_emplace(text, size);
+    if (inserted) {
+      strings.push_back(&text);
+      size += static_cast<uint32_t>(2 + text.size());
+    }
+    return it->second;
+  }
+
+  [[nodiscard]] uint32_t Size() const noexcept { return size; }
+
+  void Write(const std::span<uint8_t> bytes) const {
+    std::size_t position = 0;
+    for (const std::string* text : strings) {
+      Put16(bytes, position, static_cast<uint16_t>(text->size()));
+      std::ranges::copy(*text, bytes.subspan(position + 2).begin());
+      position += 2 + text->size();
+    }
+  }
+};
+
+std::size_t DebugInfo::SerializedSize() const {
+  StringTable strings;
+  strings.Add(file);
+  for (const DebugLine& line : lines) {
+    strings.Add(line.label);
+    strings.Add(line.text);
+  }
+  return HEADER_SIZE + lines.size() * LINE_SIZE + strings.Size();
+}
+
+void DebugInfo::Serialize(const std::span<uint8_t> bytes) const {
+  if (bytes.size() != SerializedSize()) {
+    throw std::runtime_error("Symbol map buffer has the wrong size");
+  }
+
+  StringTable strings;
+  const uint32_t file_offset = strings.Add(file);
+  std::size_t position = HEADER_SIZE;
+  for (const DebugLine& line : lines) {
+    Put16(bytes, position, line.address);
+    Put16(bytes, position + 2, line.size);
+    Put32(bytes, position + 4, line.line);
+    Put32(bytes, position + 8, file_offset);
+    Put32(bytes, position + 12, strings.Add(line.label));
+    Put32(bytes, position + 16, strings.Add(line.text));
+    position += LINE_SIZE;
+  }
+  strings.Write(bytes.subspan(position));
+
+  std::ranges::copy(MAGIC, bytes.begin());
+  bytes[MAGIC.size()] = VERSION;
+  Put32(bytes, 5, static_cast<uint32_t>(lines.size()));
+  Put32(bytes, 9, strings.Size());
+}
+
+void SymbolMap::Parse(const std::span<const uint8_t> bytes) {
+  if (!IsSymbolMap(bytes)) {
+    throw std::runtime_error("Not a DLW-1 symbol map");
+  }
+  if (const uint8_t version = bytes[DebugInfo::MAGIC.size()];
+      version != DebugInfo::VERSION) {
+    throw std::runtime_error("Unsupported symbol map version " +
+                             std::to_string(version));
+  }
+
+  line_count = Get32(bytes, 5);
+  const uint32_t strings_size = Get32(bytes, 9);
+  if (bytes.size() - HEADER_SIZE < line_count * LINE_SIZE ||
+      bytes.size() - HEADER_SIZE - line_count * LINE_SIZE != strings_size) {
+    throw std::runtime_error("Truncated symbol map");
+  }
+  lines = bytes.subspan(HEADER_SIZE, line_count * LINE_SIZE);
+  strings = bytes.subspan(HEADER_SIZE + lines.size());
+}
+
+SymbolMap::SymbolMap(const std::span<const uint8_t> bytes) { Parse(bytes); }
+
+SymbolMap::SymbolMap(std::vector<uint8_t> bytes) : buffer(std::move(bytes)) {
+  Parse(buffer);
+}
+
+SymbolMap::SymbolMap(const std::string& file_path)
+    : file(std::make_unique<InputFile>(file_path)) {
+  const std::string_view view = file->View();
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  Parse({reinterpret_cast<const uint8_t*>(view.data()), view.size()});
+}
+
+uint16_t SymbolMap::AddressAt(const std::size_t index) const noexcept {
+  return Get16(lines, index * LINE_SIZE);
+}
+
+std::string_view SymbolMap::StringAt(const uint32_t offset) const {
+  if (strings.size() < 2 || offset > strings.size() - 2 ||
+      Get16(strings, offset) > strings.size() - offset - 2) {
+    throw std::runtime_error("Corrupt symbol map string offset");
+  }
+  const std::span<const uint8_t> text =
+      strings.subspan(offset + 2, Get16(strings, offset));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return {reinterpret_cast<const char*>(text.data()), text.size()};
+}
+
+// Location of line `index` if it covers `address`
+std::optional<SourceLocation> SymbolMap::Resolve(const std::size_t index,
+                                                 const uint16_t address) const {
+  const std::size_t position = index * LINE_SIZE;
+  if (uint32_t{address} - AddressAt(index) >= Get16(lines, position + 2)) {
+    return std::nullopt;
+  }
+  return SourceLocation{.file = StringAt(Get32(lines, position + 8)),
+                        .line = Get32(lines, position + 4),
+                        .label = StringAt(Get32(lines, position + 12)),
+                        .text = StringAt(Get32(lines, position + 16))};
+}
+
+// Index of the first line after `first` that starts past `address`
+std::size_t SymbolMap::UpperBound(std::size_t first,
+                                  const uint16_t address) const noexcept {
+  std::size_t count = line_count - first;
+  while (count > 0) {
+    const std::size_t step = count / 2;
+    if (AddressAt(first + step) <= address) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+std::size_t SymbolMap::Size() const noexcept { return line_count; }
+
+std::optional<SourceLocation> SymbolMap::Lookup(const uint16_t address) const {
+  const std::size_t end = UpperBound(0, address);
+  return end == 0 ? std::nullopt : Resolve(end - 1, address);
+}
+
+std::vector<std::optional<SourceLocation>> SymbolMap::Lookup(
+    const std::span<const uint16_t> addresses) const {
+  std::vector<std::size_t> order(addresses.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::ranges::sort(order, {}, [addresses](const std::size_t i) {
+    return addresses[i];
+  });
+
+  // Each search starts where the previous, smaller address ended
+  std::vector<std::optional<SourceLocation>> locations(addresses.size());
+  std::size_t end = 0;
+  for (const std::size_t i : order) {
+    end = UpperBound(end, addresses[i]);
+    if (end > 0) {
+      locations[i] = Resolve(end - 1, addresses[i]);
+    }
+  }
+  return locations;
+}
+
+bool SymbolMap::IsSymbolMap(const std::span<const uint8_t> bytes) noexcept {
+  return bytes.size() >= HEADER_SIZE &&
+         std::ranges::equal(bytes.first(DebugInfo::MAGIC.size()),
+                            DebugInfo::MAGIC);
+}
+
+std::ostream& operator<<(std::ostream& os, const SourceLocation& location) {
+  return os << location.file << ':' << location.line << ' ' << location.text;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
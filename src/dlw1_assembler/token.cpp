@@ -28,6 +28,42 @@ std::ostream& operator<<(std::ostream& os, const TokenType& type) {
       return os << "REGISTER";
     case TokenType::RPARENTHESES:
       return os << "RPARENTHESES";
+    case TokenType::ADD:
+      return os << "ADD";
+    case TokenType::BANK:
+      return os << "BANK";
+    case TokenType::HALT:
+      return os << "HALT";
+    case TokenType::JUMP:
+      return os << "JUMP";
+    case TokenType::JUMPN:
+      return os << "JUMPN";
+    case TokenType::JUMPNZ:
+      return os << "JUMPNZ";
+    case TokenType::JUMPZ:
+      return os << "JUMPZ";
+    case TokenType::LOAD:
+      return os << "LOAD";
+    case TokenType::MOV:
+      return os << "MOV";
+    case TokenType::STORE:
+      return os << "STORE";
+    case TokenType::SUB:
+      return os << "SUB";
+    case TokenType::DIRECTIVE_BYTE:
+      return os << "DIRECTIVE_BYTE";
+    case TokenType::DIRECTIVE_DATA:
+      return os << "DIRECTIVE_DATA";
+    case TokenType::DIRECTIVE_EXTERN:
+      return os << "DIRECTIVE_EXTERN";
+    case TokenType::DIRECTIVE_GLOBAL:
+      return os << "DIRECTIVE_GLOBAL";
+    case TokenType::DIRECTIVE_ORG:
+      return os << "DIRECTIVE_ORG";
+    case TokenType::DIRECTIVE_TEXT:
+      return os << "DIRECTIVE_TEXT";
+    case TokenType::DIRECTIVE_WORD:
+      return os << "DIRECTIVE_WORD";
     default:
       return os << "UNKNOWN";
   }
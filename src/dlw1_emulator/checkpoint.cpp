@@ -0,0 +1,252 @@
+#include "dlw1_emulator/checkpoint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "dlw1_assembler/mapped_file.hpp"
+#include "dlw1_emulator/config.hpp"
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "logger/logger.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static constexpr std::size_t HEADER_SIZE =
+    4 + 1 + 8 + 4 + 2 + 1 + 1 + 1 + 1 + 1;
+
+static constexpr std::array<RegisterId, 4> REGISTERS{
+    RegisterId::A, RegisterId::B, RegisterId::C, RegisterId::D};
+
+static void Put16(const std::span<uint8_t> bytes, const std::size_t position,
+                  const uint16_t value) {
+  bytes[position] = static_cast<uint8_t>(value >> 8U);
+  bytes[position + 1] = static_cast<uint8_t>(value);
+}
+
+static void Put64(const std::span<uint8_t> bytes, const std::size_t position,
+                  const uint64_t value) {
+  for (std::size_t i = 0; i < 8; ++i) {
+    bytes[position + i] = static_cast<uint8_t>(value >> (56 - (8 * i)));
+  }
+}
+
+[[nodiscard]] static uint16_t Get16(const std::span<const uint8_t> bytes,
+                                    const std::size_t position) {
+  return static_cast<uint16_t>((bytes[position] << 8U) | bytes[position + 1]);
+}
+
+[[nodiscard]] static uint64_t Get64(const std::span<const uint8_t> bytes,
+                                    const std::size_t position) {
+  uint64_t value = 0;
+  for (std::size_t i = 0; i < 8; ++i) {
+    value = (value << 8U) | bytes[position + i];
+  }
+  return value;
+}
+
+std::size_t Checkpoint::SerializedSize() const noexcept {
+  const auto present = static_cast<std::size_t>(std::ranges::count_if(
+      banks, [](const auto& bank) { return bank != nullptr; }));
+  return HEADER_SIZE + banks.size() + (present * BANK_SIZE);
+}
+
+void Checkpoint::Serialize(const std::span<uint8_t> bytes) const {
+  if (banks.empty() || banks.size() > Config::MAX_BANKS) {
+    throw std::runtime_error("Invalid number of banks in checkpoint");
+  }
+
+  std::ranges::copy(MAGIC, bytes.begin());
+  bytes[4] = VERSION;
+  Put64(bytes, 5, cycle);
+  for (std::size_t i = 0; i < REGISTERS.size(); ++i) {
+    bytes[13 + i] = cpu.GetRegister(REGISTERS.at(i));
+  }
+  Put16(bytes, 17, cpu.GetIr());
+  bytes[19] = cpu.GetPc();
+  bytes[20] = cpu.GetPsw();
+  bytes[21] = cpu.GetHalted() ? 1 : 0;
+  bytes[22] = current_bank;
+  bytes[23] = static_cast<uint8_t>(banks.size());
+
+  std::size_t contents = HEADER_SIZE + banks.size();
+  for (std::size_t bank = 0; bank < banks.size(); ++bank) {
+    bytes[HEADER_SIZE + bank] = banks[bank] != nullptr ? 1 : 0;
+    if (banks[bank] != nullptr) {
+      std::ranges::copy(*banks[bank], bytes.subspan(contents).begin());
+      contents += BANK_SIZE;
+    }
+  }
+}
+
+void Checkpoint::Save(const std::string& path) const {
+  const std::string temporary_path = path + ".tmp";
+  try {
+    OutputFile file{temporary_path, SerializedSize()};
+    Serialize(file.Data());
+    file.Commit(true);
+  } catch (const std::exception&) {
+    std::error_code ignored;
+    std::filesystem::remove(temporary_path, ignored);
+    throw;
+  }
+  std::filesystem::rename(temporary_path, path);
+  SyncDirectoryEntry(path);
+}
+
+Checkpoint Checkpoint::Load(const std::string& path) {
+  // The banks share ownership of the mapping, which lives as long as any
+  // of them still views it
+  const auto file = std::make_shared<const InputFile>(path);
+  const std::string_view view = file->View();
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const std::span bytes{reinterpret_cast<const uint8_t*>(view.data()),
+                        view.size()};
+
+  if (bytes.size() < HEADER_SIZE ||
+      !std::ranges::equal(bytes.first(MAGIC.size()), MAGIC)) {
+    throw std::runtime_error("Not a DLW-1 checkpoint: " + path);
+  }
+  if (const uint8_t version = bytes[4]; version != VERSION) {
+    throw std::runtime_error("Unsupported checkpoint version " +
+                             std::to_string(version) + ": " + path);
+  }
+
+  Checkpoint checkpoint;
+  checkpoint.cycle = Get64(bytes, 5);
+  checkpoint.cpu = Cpu{{bytes[13], bytes[14], bytes[15], bytes[16]},
+                       Get16(bytes, 17),
+                       bytes[19],
+                       bytes[20],
+                       bytes[21] != 0};
+  checkpoint.current_bank = bytes[22];
+
+  const std::size_t bank_count = bytes[23];
+  if (bank_count == 0 || checkpoint.current_bank >= bank_count ||
+      bytes.size() < HEADER_SIZE + bank_count) {
+    throw std::runtime_error("Corrupt checkpoint: " + path);
+  }
+
+  std::size_t contents = HEADER_SIZE + bank_count;
+  checkpoint.banks.resize(bank_count);
+  for (std::size_t bank = 0; bank < bank_count; ++bank) {
+    if (bytes[HEADER_SIZE + bank] == 0) {
+      continue;
+    }
+    if (bytes.size() - contents < BANK_SIZE) {
+      throw std::runtime_error("Truncated checkpoint: " + path);
+    }
+    checkpoint.banks[bank] = std::shared_ptr<const Memory::Bank>(
+        file,
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const Memory::Bank*>(bytes.subspan(contents).data()));
+    contents += BANK_SIZE;
+  }
+
+  if (contents != bytes.size()) {
+    throw std::runtime_error("Trailing bytes after checkpoint: " + path);
+  }
+  return checkpoint;
+}
+
+CheckpointRing::CheckpointRing(const std::size_t capacity)
+    : capacity(capacity) {
+  if (capacity == 0) {
+    throw std::runtime_error("Checkpoint ring must hold at least one");
+  }
+  checkpoints.reserve(capacity);
+}
+
+void CheckpointRing::Push(Checkpoint checkpoint) {
+  if (const Checkpoint* newest = Newest();
+      newest != nullptr && checkpoint.cycle <= newest->cycle) {
+    return;
+  }
+  if (checkpoints.size() < capacity) {
+    checkpoints.push_back(std::move(checkpoint));
+  } else {
+    checkpoints[next] = std::move(checkpoint);
+  }
+  next = (next + 1) % capacity;
+}
+
+const Checkpoint* CheckpointRing::Find(const uint64_t cycle) const noexcept {
+  // Newest first, so the fewest cycles are left to replay
+  for (std::size_t i = 0; i < checkpoints.size(); ++i) {
+    const Checkpoint& checkpoint =
+        checkpoints[(next + checkpoints.size() - 1 - i) % checkpoints.size()];
+    if (checkpoint.cycle <= cycle) {
+      return &checkpoint;
+    }
+  }
+  return nullptr;
+}
+
+const Checkpoint* CheckpointRing::Oldest() const noexcept {
+  if (checkpoints.empty()) {
+    return nullptr;
+  }
+  return &checkpoints[checkpoints.size() < capacity ? 0 : next];
+}
+
+const Checkpoint* CheckpointRing::Newest() const noexcept {
+  if (checkpoints.empty()) {
+    return nullptr;
+  }
+  return &checkpoints[(next + checkpoints.size() - 1) % checkpoints.size()];
+}
+
+CheckpointWriter::CheckpointWriter(std::string path)
+    : path(std::move(path)),
+      thread([this](const std::stop_token& stop) { Work(stop); }) {}
+
+CheckpointWriter::~CheckpointWriter() {
+  thread.request_stop();
+  thread.join();
+}
+
+void CheckpointWriter::Submit(Checkpoint checkpoint) {
+  {
+    const std::scoped_lock lock{mutex};
+    pending = std::move(checkpoint);
+  }
+  submitted.notify_one();
+}
+
+void CheckpointWriter::Work(const std::stop_token& stop) {
+  while (true) {
+    std::optional<Checkpoint> checkpoint;
+    {
+      std::unique_lock lock{mutex};
+      // Returns early once stopping, after the last checkpoint is taken
+      submitted.wait(lock, stop, [this] { return pending.has_value(); });
+      if (!pending) {
+        return;
+      }
+      checkpoint.swap(pending);
+    }
+
+    try {
+      checkpoint->Save(path);
+      LOG_DEBUG("Wrote checkpoint at cycle {} to {}", checkpoint->cycle, path);
+    } catch (const std::exception& e) {
+      LOG_ERROR("Failed to write checkpoint at cycle {}: {}",
+                checkpoint->cycle, e.what());
+    }
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -1,74 +1,78 @@
 #include "dlw1_emulator/config.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <stdexcept>
 #include <string>
-#include <system_error>
 
-void Config::ValidateProgramFile(const std::string& file_path) {
-  std::error_code error_code;
-
-  if (!std::filesystem::exists(file_path, error_code)) {
-    if (error_code) {
-      throw std::filesystem::filesystem_error(
-          "Cannot check file existence for '" + file_path +
-              "': " + error_code.message(),
-          file_path, error_code);
-    }
-    throw std::filesystem::filesystem_error(
-        "Program file does not exist: " + file_path, file_path,
-        std::make_error_code(std::errc::no_such_file_or_directory));
-  }
+bool Config::ProgramIsSource() const {
+  const std::filesystem::path extension =
+      std::filesystem::path(program_file_path).extension();
+  return extension == ".s" || extension == ".asm";
+}
 
-  auto file_status = std::filesystem::status(file_path, error_code);
-  if (error_code) {
-    throw std::filesystem::filesystem_error("Cannot get file status for '" +
-                                                file_path +
-                                                "': " + error_code.message(),
-                                            file_path, error_code);
+BankProtection Config::ParseProtection(const std::string& text) {
+  const std::size_t separator = text.find(':');
+  const std::string bank = text.substr(0, separator);
+  if (separator == std::string::npos || bank.empty() ||
+      bank.find_first_not_of("0123456789") != std::string::npos ||
+      bank.size() > 3 || std::stoi(bank) > MAX_BANKS - 1) {
+    throw std::runtime_error("Invalid bank protection '" + text +
+                             "': expected BANK:FLAGS with a bank below " +
+                             std::to_string(MAX_BANKS));
   }
 
-  if (file_status.type() != std::filesystem::file_type::regular) {
-    throw std::filesystem::filesystem_error(
-        "Program file is not a regular file: " + file_path, file_path,
-        std::make_error_code(std::errc::invalid_argument));
+  const std::string flags = text.substr(separator + 1);
+  const std::runtime_error invalid_flags("Invalid bank protection '" + text +
+                                         "': flags must combine r, w and x, "
+                                         "or be -");
+  if (flags.empty()) {
+    throw invalid_flags;
   }
-
-  auto file_size = std::filesystem::file_size(file_path, error_code);
-  if (error_code) {
-    throw std::filesystem::filesystem_error("Cannot determine file size for '" +
-                                                file_path +
-                                                "': " + error_code.message(),
-                                            file_path, error_code);
+  uint8_t access = BankAccess::NONE;
+  if (flags != "-") {
+    for (const char flag : flags) {
+      const uint8_t bit = flag == 'r'   ? BankAccess::READ
+                          : flag == 'w' ? BankAccess::WRITE
+                          : flag == 'x' ? BankAccess::EXECUTE
+                                        : BankAccess::NONE;
+      if (bit == BankAccess::NONE || (access & bit) != 0) {
+        throw invalid_flags;
+      }
+      access |= bit;
+    }
   }
+  return {static_cast<uint8_t>(std::stoi(bank)), access};
+}
 
-  if (file_size == 0) {
-    throw std::filesystem::filesystem_error(
-        "Program file is empty: " + file_path, file_path,
-        std::make_error_code(std::errc::invalid_argument));
+BankAddress Config::ParseAddress(const std::string& text) {
+  const std::runtime_error invalid("Invalid address '" + text +
+                                   "': expected BANK:ADDR with a bank below " +
+                                   std::to_string(MAX_BANKS) +
+                                   " and an address below 256");
+  const std::size_t separator = text.find(':');
+  if (separator == std::string::npos) {
+    throw invalid;
   }
-
-  constexpr std::size_t MAX_PROGRAM_SIZE = std::size_t{64} * 1024;  // 64KB
-  if (file_size > MAX_PROGRAM_SIZE) {
-    throw std::filesystem::filesystem_error(
-        "Program file too large (" + std::to_string(file_size) +
-            " bytes, max: " + std::to_string(MAX_PROGRAM_SIZE) +
-            "): " + file_path,
-        file_path, std::make_error_code(std::errc::file_too_large));
+  const std::string bank = text.substr(0, separator);
+  std::string addr = text.substr(separator + 1);
+  int base = 10;
+  if (addr.starts_with("0x") || addr.starts_with("0X")) {
+    addr.erase(0, 2);
+    base = 16;
   }
-
-  auto perms = file_status.permissions();
-  if ((perms & std::filesystem::perms::owner_read) ==
-          std::filesystem::perms::none &&
-      (perms & std::filesystem::perms::group_read) ==
-          std::filesystem::perms::none &&
-      (perms & std::filesystem::perms::others_read) ==
-          std::filesystem::perms::none) {
-    throw std::filesystem::filesystem_error(
-        "Program file is not readable: " + file_path, file_path,
-        std::make_error_code(std::errc::permission_denied));
+  const char* const digits =
+      base == 16 ? "0123456789abcdefABCDEF" : "0123456789";
+  if (bank.empty() || bank.size() > 3 ||
+      bank.find_first_not_of("0123456789") != std::string::npos ||
+      std::stoi(bank) > MAX_BANKS - 1 || addr.empty() || addr.size() > 3 ||
+      addr.find_first_not_of(digits) != std::string::npos ||
+      std::stoi(addr, nullptr, base) > UINT8_MAX) {
+    throw invalid;
   }
+  return {static_cast<uint8_t>(std::stoi(bank)),
+          static_cast<uint8_t>(std::stoi(addr, nullptr, base))};
 }
 
 void Config::Validate() const {
@@ -76,11 +80,40 @@ void Config::Validate() const {
     throw std::runtime_error(
         "Invalid configuration: Program file path is empty.");
   }
-  ValidateProgramFile(program_file_path);
+  // The program file is opened and sized once by the loader, which reports
+  // missing, unreadable, empty and oversized files without a separate round
+  // of stat calls
 
   if (num_banks < MIN_BANKS || num_banks > MAX_BANKS) {
     throw std::runtime_error(
         "Invalid configuration: Number of banks must be between " +
         std::to_string(MIN_BANKS) + " and " + std::to_string(MAX_BANKS));
   }
+
+  for (const BankProtection& protection : protections) {
+    if (protection.bank >= num_banks) {
+      throw std::runtime_error(
+          "Invalid configuration: Protected bank " +
+          std::to_string(protection.bank) + " does not exist");
+    }
+  }
+
+  if (back_to_write && back_to_write->bank >= num_banks) {
+    throw std::runtime_error("Invalid configuration: Bank " +
+                             std::to_string(back_to_write->bank) +
+                             " does not exist");
+  }
+  if ((goto_cycle || back_to_write) && snapshot_interval == 0) {
+    throw std::runtime_error(
+        "Invalid configuration: Time travel needs a snapshot interval.");
+  }
+  if (snapshot_interval > 0 && snapshot_count == 0) {
+    throw std::runtime_error(
+        "Invalid configuration: Time travel needs at least one snapshot.");
+  }
+
+  if (checkpoint_interval > 0 && checkpoint_file_path.empty()) {
+    throw std::runtime_error(
+        "Invalid configuration: Checkpoint file path is empty.");
+  }
 }
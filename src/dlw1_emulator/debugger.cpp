@@ -0,0 +1,240 @@
+#include "dlw1_emulator/debugger.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "dlw1_emulator/config.hpp"
+#include "dlw1_emulator/formatters.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "fmt/format.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// Bytes per hex dump row, and bytes dumped when no count is given
+static constexpr std::size_t DUMP_ROW_SIZE = 16;
+static constexpr std::size_t DEFAULT_DUMP_SIZE = 64;
+
+static constexpr std::string_view HELP =
+    "Commands:\n"
+    "  s, step [N]               Run N instructions (default: 1)\n"
+    "  c, continue               Run until a breakpoint, watchpoint or halt\n"
+    "  b, break BANK:ADDR        Stop before the instruction at BANK:ADDR\n"
+    "  d, delete BANK:ADDR       Remove a breakpoint\n"
+    "  w, watch BANK:ADDR        Stop after the byte at BANK:ADDR changes\n"
+    "  u, unwatch BANK:ADDR      Remove a watchpoint\n"
+    "  r, registers              Print the CPU state\n"
+    "  x, dump BANK:ADDR [N]     Print N bytes in hex (default: 64)\n"
+    "  back                      Go back one instruction\n"
+    "  goto N                    Go to the state after cycle N\n"
+    "  back-to-write BANK:ADDR   Go back to the last change to a byte\n"
+    "  q, quit                   End the session\n";
+
+[[nodiscard]] static uint64_t ParseCount(const std::string& text) {
+  if (text.empty() || text.size() > 19 ||
+      text.find_first_not_of("0123456789") != std::string::npos) {
+    throw std::runtime_error("Invalid number '" + text + "'");
+  }
+  return std::stoull(text);
+}
+
+Debugger::Debugger(Emulator& emulator)
+    : emulator{emulator}, breakpoints(emulator.memory.GetNumBanks()) {}
+
+std::size_t Debugger::NextBreakpoint(const uint8_t bank,
+                                     const std::size_t from) const noexcept {
+  const Bitmap& words = breakpoints[bank];
+  for (std::size_t word = from / 64; word < BITMAP_WORDS; ++word) {
+    uint64_t bits = words.at(word);
+    if (word == from / 64) {
+      bits &= ~uint64_t{0} << (from % 64);
+    }
+    if (bits != 0) {
+      return (word * 64) + static_cast<std::size_t>(std::countr_zero(bits));
+    }
+  }
+  return BANK_SIZE;
+}
+
+void Debugger::SetBreakpoint(const uint8_t bank, const uint8_t addr,
+                             const bool enabled) {
+  uint64_t& word = breakpoints[bank].at(addr / 64U);
+  const uint64_t bit = uint64_t{1} << (addr % 64U);
+  word = enabled ? word | bit : word & ~bit;
+}
+
+bool Debugger::ReportWatchHit(std::ostream& output) {
+  Memory& memory = emulator.memory;
+  if (!memory.GetWatchHit()) {
+    return false;
+  }
+  output << "Watchpoint: " << fmt::format("{}", *memory.GetWatchHit())
+         << "\n";
+  memory.ClearWatchHit();
+  return true;
+}
+
+void Debugger::Continue(std::ostream& output) {
+  const Cpu& cpu = emulator.cpu;
+  const Memory& memory = emulator.memory;
+
+  // Leaving a breakpoint runs its instruction first
+  std::size_t stop =
+      NextBreakpoint(memory.GetCurrentBank(), cpu.GetPc() + 1U);
+  while (!cpu.GetHalted()) {
+    const uint8_t bank = memory.GetCurrentBank();
+    const uint8_t pc = cpu.GetPc();
+    emulator.Step(emulator.memory);
+    if (ReportWatchHit(output)) {
+      return;
+    }
+
+    // A new block starts wherever execution did not fall through. Falling
+    // through can also step over the breakpoint, e.g. one at an odd address
+    if (memory.GetCurrentBank() != bank || cpu.GetPc() != pc + 2U ||
+        cpu.GetPc() > stop) {
+      stop = NextBreakpoint(memory.GetCurrentBank(), cpu.GetPc());
+    }
+    if (cpu.GetPc() == stop) {
+      output << "Breakpoint\n";
+      return;
+    }
+  }
+  output << "Program halted\n";
+}
+
+void Debugger::Step(const uint64_t count, std::ostream& output) {
+  for (uint64_t i = 0; i < count; ++i) {
+    if (emulator.cpu.GetHalted()) {
+      output << "Program halted\n";
+      return;
+    }
+    emulator.Step(emulator.memory);
+    if (ReportWatchHit(output)) {
+      return;
+    }
+  }
+}
+
+void Debugger::Dump(const uint8_t bank, const uint8_t addr,
+                    const std::size_t count, std::ostream& output) const {
+  const std::size_t end = std::min(std::size_t{addr} + count, BANK_SIZE);
+  for (std::size_t row = addr; row < end; row += DUMP_ROW_SIZE) {
+    output << fmt::format("{:>3}:{:#04x} ", bank, row);
+    for (std::size_t i = row; i < std::min(row + DUMP_ROW_SIZE, end); ++i) {
+      output << fmt::format(
+          " {:02X}", emulator.memory.ReadByte(bank, static_cast<uint8_t>(i)));
+    }
+    output << "\n";
+  }
+}
+
+bool Debugger::Execute(const std::string& line, std::ostream& output) {
+  std::istringstream words{line};
+  std::string command;
+  std::string argument;
+  std::string count;
+  words >> command >> argument >> count;
+
+  // Commands that take a BANK:ADDR argument
+  const auto address = [&] {
+    const BankAddress parsed = Config::ParseAddress(argument);
+    if (parsed.bank >= emulator.memory.GetNumBanks()) {
+      throw std::runtime_error("Bank " + std::to_string(parsed.bank) +
+                               " does not exist");
+    }
+    return parsed;
+  };
+
+  if (command.empty()) {
+    return true;
+  }
+  if (command == "q" || command == "quit") {
+    return false;
+  }
+  if (command == "h" || command == "help") {
+    output << HELP;
+    return true;
+  }
+  if (command == "b" || command == "break" || command == "d" ||
+      command == "delete") {
+    const BankAddress breakpoint = address();
+    SetBreakpoint(breakpoint.bank, breakpoint.addr,
+                  command == "b" || command == "break");
+    return true;
+  }
+  if (command == "w" || command == "watch" || command == "u" ||
+      command == "unwatch") {
+    const BankAddress watchpoint = address();
+    emulator.memory.Watch(watchpoint.bank, watchpoint.addr,
+                          command == "w" || command == "watch");
+    return true;
+  }
+  if (command == "r" || command == "registers") {
+    output << fmt::format("{}", emulator.cpu) << "\n";
+    return true;
+  }
+  if (command == "x" || command == "dump") {
+    const BankAddress start = address();
+    Dump(start.bank, start.addr,
+         count.empty() ? DEFAULT_DUMP_SIZE : ParseCount(count), output);
+    return true;
+  }
+
+  // Commands that move through time print where they arrive
+  if (command == "s" || command == "step") {
+    Step(argument.empty() ? 1 : ParseCount(argument), output);
+  } else if (command == "c" || command == "continue") {
+    Continue(output);
+  } else if (command == "back") {
+    emulator.StepBack();
+  } else if (command == "goto") {
+    emulator.GotoCycle(ParseCount(argument));
+  } else if (command == "back-to-write") {
+    const BankAddress byte = address();
+    if (const std::optional<uint64_t> writer =
+            emulator.RunBackToWrite(byte.bank, byte.addr)) {
+      output << "Last changed at cycle " << *writer << "\n";
+    } else {
+      output << "Not changed since the oldest snapshot\n";
+    }
+  } else {
+    output << "Unknown command '" << command << "', try help\n";
+    return true;
+  }
+
+  // Changes found while replaying belong to the past
+  emulator.memory.ClearWatchHit();
+  output << emulator.DescribePosition() << "\n";
+  return true;
+}
+
+void Debugger::Repl(std::istream& input, std::ostream& output) {
+  emulator.Start();
+  output << emulator.DescribePosition() << "\n";
+
+  std::string line;
+  output << "(dlw1) " << std::flush;
+  while (std::getline(input, line)) {
+    try {
+      if (!Execute(line, output)) {
+        return;
+      }
+    } catch (const std::exception& e) {
+      // The session survives faults, e.g. to go back before one
+      output << "Error: " << e.what() << "\n";
+    }
+    output << "(dlw1) " << std::flush;
+  }
+  output << "\n";
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -0,0 +1,263 @@
+#include "dlw1_emulator/disassembler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,cppcoreguidelines-pro-bounds-constant-array-index,hicpp-signed-bitwise,readability-magic-numbers)
+
+// Fixed-capacity string that can be built at compile time
+template <std::size_t Capacity>
+struct Text {
+  std::array<char, Capacity> data{};
+  uint8_t size = 0;
+
+  constexpr Text& operator+=(const std::string_view text) {
+    for (const char c : text) {
+      data[size++] = c;
+    }
+    return *this;
+  }
+
+  constexpr Text& operator+=(const char c) {
+    data[size++] = c;
+    return *this;
+  }
+
+  [[nodiscard]] constexpr std::string_view View() const noexcept {
+    return {data.data(), size};
+  }
+};
+
+using Operand = Text<8>;
+
+// What the high byte of an instruction renders to
+enum class OperandKind : uint8_t {
+  NONE,
+  REGISTER,       // Bits 8-9 select a register
+  DECIMAL,        // Unsigned immediate
+  ADDRESS,        // In-bank address, as two hex digits
+  OFFSET,         // Signed 8-bit displacement, "+ #5" or "- #1"
+  JUMP_OFFSET,    // Signed 9-bit offset, completed by bit 7 of the low byte
+  JUMP_REGISTER,  // "jump rX" if the high byte is zero, "halt" otherwise
+};
+
+struct Pattern {
+  Text<16> prefix;
+  OperandKind kind = OperandKind::NONE;
+  Text<4> suffix;
+};
+
+static constexpr std::array<std::string_view, 4> REGISTER_NAMES{"ra", "rb",
+                                                                "rc", "rd"};
+static constexpr std::array<std::string_view, 8> MNEMONICS{
+    "add", "sub", "load", "store", "jump", "jumpz", "jumpnz", "jumpn"};
+
+static constexpr void AppendDecimal(Operand& operand, const uint32_t value) {
+  if (value >= 10) {
+    AppendDecimal(operand, value / 10);
+  }
+  operand += static_cast<char>('0' + value % 10);
+}
+
+static constexpr Pattern MakePattern(const uint8_t low) {
+  const uint8_t opcode = (low >> 1U) & 0b111U;
+  const bool mode_bit = (low & 0b1U) != 0;
+  const std::string_view reg4 = REGISTER_NAMES[(low >> 4U) & 0b11U];
+  const std::string_view reg6 = REGISTER_NAMES[(low >> 6U) & 0b11U];
+  const bool has_base = ((low >> 4U) & 0b11U) != 0;
+  const bool has_reg6 = ((low >> 6U) & 0b11U) != 0;
+
+  Pattern pattern;
+  Text<16>& prefix = pattern.prefix;
+  const std::string_view mnemonic = MNEMONICS[opcode];
+
+  switch (opcode) {
+    case 0b000:  // add
+    case 0b001:  // sub
+      prefix += mnemonic;
+      prefix += ' ';
+      prefix += reg4;
+      if (mode_bit) {
+        prefix += ", #";
+        pattern.kind = OperandKind::DECIMAL;
+        pattern.suffix += ", ";
+        pattern.suffix += reg6;
+      } else {
+        prefix += ", ";
+        prefix += reg6;
+        prefix += ", ";
+        pattern.kind = OperandKind::REGISTER;
+      }
+      break;
+    case 0b010:  // load
+    case 0b011:  // store
+      if (mode_bit) {
+        prefix += mnemonic;
+        prefix += ' ';
+        prefix += reg6;
+        if (has_base) {
+          prefix += ", (";
+          prefix += reg4;
+          prefix += ' ';
+          pattern.kind = OperandKind::OFFSET;
+          pattern.suffix += ')';
+        } else {
+          prefix += ", #0x";
+          pattern.kind = OperandKind::ADDRESS;
+        }
+      } else if (opcode == 0b010 && has_reg6) {
+        prefix += "bank #";
+        pattern.kind = OperandKind::DECIMAL;
+      } else if (opcode == 0b010) {
+        prefix += "load ";
+        pattern.kind = OperandKind::REGISTER;
+        pattern.suffix += ", ";
+        pattern.suffix += reg4;
+      } else {
+        prefix += has_reg6 ? "mov " : "store ";
+        prefix += reg4;
+        prefix += ", ";
+        pattern.kind = OperandKind::REGISTER;
+      }
+      break;
+    default:  // jumps
+      prefix += mnemonic;
+      if (mode_bit) {
+        prefix += has_base ? " (" : " #0x";
+        pattern.kind =
+            has_base ? OperandKind::JUMP_OFFSET : OperandKind::ADDRESS;
+        if (has_base) {
+          pattern.suffix += ')';
+        }
+      } else if (!has_reg6) {
+        prefix += ' ';
+        prefix += reg4;
+        pattern.kind = OperandKind::JUMP_REGISTER;
+      } else {
+        pattern.prefix = {};
+        prefix += "halt";
+      }
+      break;
+  }
+  return pattern;
+}
+
+static constexpr std::array<Pattern, 256> PATTERNS = [] {
+  std::array<Pattern, 256> patterns{};
+  for (std::size_t low = 0; low < patterns.size(); ++low) {
+    patterns[low] = MakePattern(static_cast<uint8_t>(low));
+  }
+  return patterns;
+}();
+
+static constexpr std::array<Operand, 256> DECIMALS = [] {
+  std::array<Operand, 256> operands{};
+  for (uint32_t value = 0; value < operands.size(); ++value) {
+    AppendDecimal(operands[value], value);
+  }
+  return operands;
+}();
+
+static constexpr std::array<Operand, 256> ADDRESSES = [] {
+  constexpr std::string_view DIGITS = "0123456789ABCDEF";
+  std::array<Operand, 256> operands{};
+  for (std::size_t value = 0; value < operands.size(); ++value) {
+    operands[value] += DIGITS[value >> 4U];
+    operands[value] += DIGITS[value & 0xFU];
+  }
+  return operands;
+}();
+
+static constexpr std::array<Operand, 256> OFFSETS = [] {
+  std::array<Operand, 256> operands{};
+  for (std::size_t value = 0; value < operands.size(); ++value) {
+    const auto offset = static_cast<int8_t>(value);
+    operands[value] += offset < 0 ? "- #" : "+ #";
+    AppendDecimal(operands[value],
+                  static_cast<uint32_t>(offset < 0 ? -offset : offset));
+  }
+  return operands;
+}();
+
+static constexpr std::array<Operand, 512> JUMP_OFFSETS = [] {
+  std::array<Operand, 512> operands{};
+  for (int32_t value = 0; value < 512; ++value) {
+    const int32_t offset = value >= 256 ? value - 512 : value;
+    operands[value] += offset < 0 ? "-#" : "+#";
+    AppendDecimal(operands[value],
+                  static_cast<uint32_t>(offset < 0 ? -offset : offset));
+  }
+  return operands;
+}();
+
+static constexpr std::array<Operand, 4> REGISTERS = [] {
+  std::array<Operand, 4> operands{};
+  for (std::size_t reg = 0; reg < operands.size(); ++reg) {
+    operands[reg] += REGISTER_NAMES[reg];
+  }
+  return operands;
+}();
+
+static constexpr Operand NO_OPERAND{};
+static constexpr uint8_t HALT = 0xC8;  // Low byte of a canonical halt
+
+static_assert(PATTERNS[0x42].prefix.View() == "sub ra, rb, ");
+static_assert(PATTERNS[HALT].prefix.View() == "halt");
+
+// Every piece is copied whole, so the buffer must hold the longest prefix,
+// operand and suffix back to back
+static_assert(std::ranges::max(PATTERNS, {}, [](const Pattern& pattern) {
+                return pattern.prefix.size;
+              }).prefix.size +
+                  Operand{}.data.size() + Text<4>{}.data.size() <=
+              Disassembler::MAX_TEXT_SIZE);
+
+std::string_view Disassembler::Disassemble(
+    const uint16_t ir, const std::span<char, MAX_TEXT_SIZE> buffer) noexcept {
+  const Pattern& pattern = PATTERNS[ir & 0xFFU];
+  const uint8_t high = ir >> 8U;
+
+  const Operand* operand = &NO_OPERAND;
+  switch (pattern.kind) {
+    case OperandKind::REGISTER:
+      operand = &REGISTERS[high & 0b11U];
+      break;
+    case OperandKind::DECIMAL:
+      operand = &DECIMALS[high];
+      break;
+    case OperandKind::ADDRESS:
+      operand = &ADDRESSES[high];
+      break;
+    case OperandKind::OFFSET:
+      operand = &OFFSETS[high];
+      break;
+    case OperandKind::JUMP_OFFSET:
+      operand = &JUMP_OFFSETS[(ir >> 7U) & 0x1FFU];
+      break;
+    case OperandKind::JUMP_REGISTER:
+      if (high != 0) {
+        std::ranges::copy(PATTERNS[HALT].prefix.data, buffer.begin());
+        return {buffer.data(), PATTERNS[HALT].prefix.size};
+      }
+      break;
+    default:
+      break;
+  }
+
+  // Whole fixed-size pieces are copied and the next one overwrites the
+  // unused tail, which compiles to a few wide moves instead of loops
+  std::size_t size = 0;
+  std::ranges::copy(pattern.prefix.data, buffer.begin());
+  size += pattern.prefix.size;
+  std::ranges::copy(operand->data, buffer.subspan(size).begin());
+  size += operand->size;
+  std::ranges::copy(pattern.suffix.data, buffer.subspan(size).begin());
+  size += pattern.suffix.size;
+  return {buffer.data(), size};
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,cppcoreguidelines-pro-bounds-constant-array-index,hicpp-signed-bitwise,readability-magic-numbers)
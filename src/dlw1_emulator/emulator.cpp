@@ -1,88 +1,531 @@
 #include "dlw1_emulator/emulator.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
-#include <fstream>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_assembler/mapped_file.hpp"
+#include "dlw1_assembler/program_image.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
+#include "dlw1_emulator/banked_memory.hpp"
+#include "dlw1_emulator/checkpoint.hpp"
+#include "dlw1_emulator/disassembler.hpp"
+#include "dlw1_emulator/formatters.hpp"
 #include "dlw1_emulator/helpers.hpp"
 #include "dlw1_emulator/instruction.hpp"
 #include "dlw1_emulator/memory.hpp"
+#include "dlw1_emulator/observers.hpp"
 #include "logger/logger.hpp"
 
-void Emulator::LoadProgram() {
-  LOG_DEBUG("Loading program from: {}", config.program_file_path);
+// Number of most executed instructions reported after a run
+static constexpr std::size_t PROFILE_REPORT_SIZE = 5;
+
+// Finds the last cycle that changed a byte
+struct WriteFinder : ExecutionObserver {
+  const uint64_t& cycle;
+  uint8_t bank;
+  uint8_t addr;
+  std::optional<uint64_t> writer;
+
+  void OnMemWrite(const MemoryWrite& write) noexcept {
+    if (write.bank == bank && write.addr == addr &&
+        write.old_value != write.new_value) {
+      writer = cycle;
+    }
+  }
+};
+
+// Source location of an instruction, or its disassembly without a map
+[[nodiscard]] static std::string DescribeAddress(
+    const uint16_t address, const uint16_t ir,
+    const std::optional<SourceLocation>& location) {
+  std::string text = "bank " + std::to_string(address >> 8U) + " address " +
+                     std::to_string(address & 0xFFU);
+  if (location) {
+    text += " (" + to_string(*location) + ")";
+  } else {
+    std::array<char, Disassembler::MAX_TEXT_SIZE> buffer{};
+    text += ": ";
+    text += Disassembler::Disassemble(ir, buffer);
+  }
+  return text;
+}
+
+void Emulator::LoadImage(const std::span<const uint8_t> image) {
+  if (image.size() > std::size_t{memory.GetNumBanks()} * BANK_SIZE) {
+    throw std::runtime_error(
+        "Program too large: exceeds available memory banks");
+  }
+  memory.LoadBytes(0, image);
+}
+
+void Emulator::LoadSegments(const ProgramImage& image) {
+  const std::size_t memory_size = std::size_t{memory.GetNumBanks()} * BANK_SIZE;
+  // Protection is per bank, so a read-only segment protects every bank it
+  // touches and must not share one with a writable segment
+  std::vector<uint8_t> read_only(memory.GetNumBanks());
+  std::vector<uint8_t> writable(memory.GetNumBanks());
+  for (const ImageSegment& segment : image.segments) {
+    if (segment.address + segment.bytes.size() > memory_size) {
+      throw std::runtime_error(
+          "Segment at bank " + std::to_string(segment.address >> 8U) +
+          " address " + std::to_string(segment.address & 0xFFU) +
+          " exceeds available memory banks");
+    }
+    if (segment.bytes.empty()) {
+      continue;
+    }
+    std::vector<uint8_t>& banks =
+        (segment.flags & ImageSegment::READ_ONLY) != 0 ? read_only : writable;
+    const std::size_t last = segment.address + segment.bytes.size() - 1;
+    for (std::size_t bank = segment.address / BANK_SIZE;
+         bank <= last / BANK_SIZE; ++bank) {
+      banks[bank] = 1;
+    }
+  }
+  for (std::size_t bank = 0; bank < read_only.size(); ++bank) {
+    if (read_only[bank] != 0 && writable[bank] != 0) {
+      throw std::runtime_error("Bank " + std::to_string(bank) +
+                               " holds both read-only and writable segments");
+    }
+  }
+
+  for (const ImageSegment& segment : image.segments) {
+    memory.LoadBytes(segment.address, segment.bytes);
+  }
+  for (std::size_t bank = 0; bank < read_only.size(); ++bank) {
+    if (read_only[bank] != 0) {
+      const auto index = static_cast<uint8_t>(bank);
+      memory.SetAccess(index, memory.GetAccess(index) & ~BankAccess::WRITE);
+    }
+  }
+
+  if (image.entry >= memory_size) {
+    throw std::runtime_error("Entry point at bank " +
+                             std::to_string(image.entry >> 8U) +
+                             " is outside available memory banks");
+  }
+  memory.SetCurrentBank(static_cast<uint8_t>(image.entry >> 8U));
+  cpu = Cpu{{}, 0, static_cast<uint8_t>(image.entry), 0, false};
+
+  LOG_INFO("Loaded {} segments, entry point at bank {} address {}",
+           image.segments.size(), image.entry >> 8U, image.entry & 0xFFU);
+}
 
-  std::ifstream program_file(config.program_file_path, std::ios::binary);
-  if (!program_file) {
-    throw std::runtime_error("Failed to open program file: " +
+void Emulator::ReadProgram() {
+  // One open, fstat and mmap; the file size comes from the fstat
+  const InputFile program_file{config.program_file_path};
+  const std::string_view view = program_file.View();
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const std::span bytes{reinterpret_cast<const uint8_t*>(view.data()),
+                        view.size()};
+  if (bytes.empty()) {
+    throw std::runtime_error("Program file is empty: " +
                              config.program_file_path);
   }
+  if (bytes.size() > ProgramImage::MAX_SIZE) {
+    throw std::runtime_error("Program file too large (" +
+                             std::to_string(bytes.size()) + " bytes, max: " +
+                             std::to_string(ProgramImage::MAX_SIZE) +
+                             "): " + config.program_file_path);
+  }
+
+  // Sectioned images are copied straight from the mapping into the banks;
+  // anything else is a flat image
+  if (ProgramImage::IsImage(bytes)) {
+    LoadSegments(ProgramImage::Deserialize(bytes));
+  } else {
+    LoadImage(bytes);
+  }
+
+  LOG_INFO("Successfully loaded {} bytes from program file", bytes.size());
+}
+
+void Emulator::AssembleProgram() {
+  const InputFile source_file{config.program_file_path};
+  Assembler assembler;
+  const std::vector<uint8_t> image = assembler.Assemble(source_file.View());
+  LoadImage(image);
+
+  // The symbol map comes for free, without a .dbg file
+  const DebugInfo info =
+      assembler.BuildDebugInfo(source_file.View(), config.program_file_path);
+  std::vector<uint8_t> symbol_bytes(info.SerializedSize());
+  info.Serialize(symbol_bytes);
+  symbols.emplace(std::move(symbol_bytes));
+
+  LOG_INFO("Assembled {} lines into {} bytes", assembler.GetStats().lines,
+           image.size());
+}
+
+void Emulator::LoadProgram() {
+  LOG_DEBUG("Loading program from: {}", config.program_file_path);
 
   try {
-    uint8_t addr = 0;
-    std::size_t bytes_read = 0;
-    uint8_t bank = 0;
-    memory.SetCurrentBank(bank);
-
-    uint8_t byte = 0;
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    while (program_file.read(reinterpret_cast<char*>(&byte), 1)) {
-      memory.WriteByte(addr++, byte);
-      bytes_read++;
-
-      // When we reach the end of a bank, move to the next bank
-      if (addr == 0) {  // Overflow to 0 after 255
-        bank++;
-        if (bank >= memory.GetNumBanks()) {
-          throw std::runtime_error(
-              "Program too large: exceeds available memory banks");
-        }
-        memory.SetCurrentBank(bank);
-      }
+    if (config.ProgramIsSource()) {
+      AssembleProgram();
+    } else {
+      ReadProgram();
     }
+  } catch (const std::exception& e) {
+    throw std::runtime_error("Failed to load program: " +
+                             std::string(e.what()));
+  }
 
-    // Reset to bank 0 after loading
-    memory.SetCurrentBank(0);
+  LoadSymbols();
+  ProtectBanks();
+  Resume();
+}
 
-    if (program_file.bad()) {
-      throw std::runtime_error("Error occured while reading program file");
-    }
+void Emulator::LoadProgram(const Memory::SharedBanks& program) {
+  if (program.size() != config.num_banks) {
+    throw std::runtime_error("Failed to load program: shared program has " +
+                             std::to_string(program.size()) +
+                             " banks, expected " +
+                             std::to_string(config.num_banks));
+  }
+  memory = Memory{program};
+  LoadSymbols();
+  ProtectBanks();
+  Resume();
+}
 
-    LOG_INFO("Successfully loaded {} bytes from program file", bytes_read);
+void Emulator::Resume() {
+  if (config.resume_file_path.empty()) {
+    return;
+  }
+
+  Checkpoint checkpoint;
+  try {
+    checkpoint = Checkpoint::Load(config.resume_file_path);
   } catch (const std::exception& e) {
-    throw std::runtime_error("Failed to load program: " +
+    throw std::runtime_error("Failed to load checkpoint: " +
                              std::string(e.what()));
   }
+  if (checkpoint.banks.size() != memory.GetNumBanks()) {
+    throw std::runtime_error("Failed to load checkpoint: checkpoint has " +
+                             std::to_string(checkpoint.banks.size()) +
+                             " banks, expected " +
+                             std::to_string(memory.GetNumBanks()));
+  }
+
+  // The banks keep viewing the checkpoint's mapping until written
+  Restore(checkpoint);
+
+  LOG_INFO("Resumed from checkpoint at cycle {}: {}", cycle_count,
+           config.resume_file_path);
 }
 
-void Emulator::Run() {
+void Emulator::Restore(const Checkpoint& checkpoint) {
+  memory.Restore(checkpoint.banks);
+  memory.SetCurrentBank(checkpoint.current_bank);
+  cpu = checkpoint.cpu;
+  cycle_count = checkpoint.cycle;
+}
+
+Memory::SharedBanks Emulator::ShareProgram() { return memory.Share(); }
+
+void Emulator::ProtectBanks() {
+  for (const BankProtection& protection : config.protections) {
+    memory.SetAccess(protection.bank, protection.access);
+  }
+}
+
+void Emulator::Fault(const MemoryFault& fault, const uint16_t address,
+                     const uint16_t ir) const {
+  const std::string_view access = fault.access == BankAccess::READ  ? "read"
+                                  : fault.access == BankAccess::WRITE
+                                      ? "write"
+                                      : "execute";
+  const std::string location = DescribeAddress(
+      address, ir, symbols ? symbols->Lookup(address) : std::nullopt);
+  throw std::runtime_error(
+      "Memory fault: " + std::string(access) + " access to bank " +
+      std::to_string(fault.bank) + " address " +
+      std::to_string(fault.addr) + " denied, at PC " + location);
+}
+
+void Emulator::LoadSymbols() {
+  if (!symbols && !config.symbol_file_path.empty()) {
+    try {
+      symbols.emplace(config.symbol_file_path);
+      LOG_INFO("Loaded {} source lines from symbol map: {}", symbols->Size(),
+               config.symbol_file_path);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("Failed to load symbol map: " +
+                               std::string(e.what()));
+    }
+  }
+}
+
+bool Emulator::RecordsState(const uint64_t cycle) const noexcept {
+  return (snapshots && cycle % config.snapshot_interval == 0) ||
+         (config.checkpoint_interval > 0 &&
+          cycle % config.checkpoint_interval == 0);
+}
+
+template <bool Fuse, typename MemoryBus, typename... Observers>
+uint16_t Emulator::Step(MemoryBus& bus, Observers&... observers) {
+  static_assert(sizeof...(Observers) == 0 || std::is_same_v<MemoryBus, Memory>,
+                "Observed cycles run against the memory itself");
+  static_assert(!Fuse || sizeof...(Observers) == 0,
+                "Observers see every instruction on its own");
+
+  cycle_count++;
+  const auto address =
+      static_cast<uint16_t>((bus.GetCurrentBank() << 8U) | cpu.GetPc());
+
+  if ((bus.GetAccess(bus.GetCurrentBank()) & BankAccess::EXECUTE) == 0)
+      [[unlikely]] {
+    const auto ir = static_cast<uint16_t>(
+        (bus.ReadByte(cpu.GetPc()) << 8U) |
+        bus.ReadByte(static_cast<uint8_t>(cpu.GetPc() + 1)));
+    Fault({bus.GetCurrentBank(), cpu.GetPc(), BankAccess::EXECUTE}, address,
+          ir);
+  }
+  cpu.Fetch(bus);
+
+  const Instruction ins = cpu.Decode();
+  if constexpr (Fuse) {
+    // The second instruction runs from the same bank, so it may execute.
+    // A load that faults runs alone, so the run stops right after it.
+    const uint8_t next_pc = cpu.GetPc();
+    if (!RecordsState(cycle_count) &&
+        (ins.opcode != Opcode::LOAD ||
+         (bus.GetAccess(bus.GetCurrentBank()) & BankAccess::READ) != 0) &&
+        cpu.ExecuteFused(ins, bus)) {
+      cycle_count++;
+      ++profile[(bus.GetCurrentBank() << 8U) | next_pc];
+    } else {
+      cpu.Execute(ins, bus);
+    }
+  } else if constexpr (sizeof...(Observers) == 0) {
+    cpu.Execute(ins, bus);
+  } else {
+    ObservedMemory<Observers...> observed{memory, observers...};
+    cpu.Execute(ins, observed);
+  }
+  if (memory.GetFault()) [[unlikely]] {
+    Fault(*memory.GetFault(), address, ins.raw);
+  }
+  (observers.OnRetire(ins, cpu), ...);
+
+  if (snapshots && cycle_count % config.snapshot_interval == 0) {
+    snapshots->Push({cycle_count, cpu, memory.GetCurrentBank(),
+                     memory.Share()});
+    if constexpr (!std::is_same_v<MemoryBus, Memory>) {
+      bus.Sync();
+    }
+  }
+  return address;
+}
+
+// The debugger steps the memory without observers
+template uint16_t Emulator::Step(Memory& bus);
+
+void Emulator::Start() {
   LOG_DEBUG("Starting emulator execution");
-  LOG_DEBUG("Initial memory state: \n{}", to_string(memory));
+  LOG_DEBUG("Initial memory state: \n{}", memory);
 
-  size_t cycle_count = 0;
+  if (config.snapshot_interval > 0) {
+    snapshots.emplace(config.snapshot_count);
+    snapshots->Push(
+        {cycle_count, cpu, memory.GetCurrentBank(), memory.Share()});
+  }
+  profile.assign(std::size_t{memory.GetNumBanks()} * BANK_SIZE, 0);
+}
 
+template <typename MemoryBus, typename... Observers>
+uint16_t Emulator::RunLoop(MemoryBus& bus,
+                           std::optional<CheckpointWriter>& checkpoints,
+                           Observers&... observers) {
+  uint16_t address = 0;
   while (!cpu.GetHalted()) {
-    cycle_count++;
+    address = Step<sizeof...(Observers) == 0>(bus, observers...);
+    ++profile[address];
 
-    LOG_DEBUG("Cycle {}: Fetching instruction", cycle_count);
-    cpu.Fetch(memory);
+    if (checkpoints && cycle_count % config.checkpoint_interval == 0) {
+      // Sharing the banks copies no memory; banks written after this copy
+      // themselves
+      checkpoints->Submit({cycle_count, cpu, memory.GetCurrentBank(),
+                           memory.Share()});
+      if constexpr (!std::is_same_v<MemoryBus, Memory>) {
+        bus.Sync();
+      }
+    }
+  }
+  return address;
+}
 
-    LOG_DEBUG("Cycle {}: Decoding instruction", cycle_count);
-    const Instruction ins = cpu.Decode();
-    LOG_INFO("Instruction: \n{}", to_string(ins));
+template <uint8_t NumBanks>
+void Emulator::Run() {
+  if (NumBanks != 0 && NumBanks != memory.GetNumBanks()) {
+    throw std::runtime_error("Emulator specialized for " +
+                             std::to_string(NumBanks) + " banks, but " +
+                             std::to_string(memory.GetNumBanks()) +
+                             " are configured");
+  }
+  Start();
 
-    LOG_DEBUG("Cycle {}: Executing instruction", cycle_count);
-    cpu.Execute(ins, memory);
-    LOG_INFO("CPU State: \n{}", to_string(cpu));
+  // Writes the last submitted checkpoint when Run returns
+  std::optional<CheckpointWriter> checkpoints;
+  if (config.checkpoint_interval > 0) {
+    checkpoints.emplace(config.checkpoint_file_path);
+  }
 
-    LOG_DEBUG("Cycle {}: Final memory state: \n{}", cycle_count,
-              to_string(memory));
+  // Without per instruction logging the loop runs unobserved
+  uint16_t address = 0;
+  if (Logger::GetLogger() &&
+      Logger::GetLogger()->should_log(spdlog::level::info)) {
+    LoggingObserver logging{cycle_count};
+    address = RunLoop(memory, checkpoints, logging);
+  } else if constexpr (NumBanks == 0) {
+    address = RunLoop(memory, checkpoints);
+  } else {
+    BankedMemory<NumBanks> banked{memory};
+    address = RunLoop(banked, checkpoints);
   }
 
-  LOG_DEBUG("Final memory state: \n{}", to_string(memory));
+  LOG_DEBUG("Final memory state: \n{}", memory);
   LOG_DEBUG("Emulation completed after {} cycles", cycle_count);
+  LOG_DEBUG("Memory: {} of {} banks allocated, {} bytes",
+            memory.GetAllocatedBanks(), memory.GetNumBanks(),
+            memory.GetAllocatedBytes());
+  Report(address);
+}
+
+template void Emulator::Run<0>();
+template void Emulator::Run<1>();
+template void Emulator::Run<2>();
+template void Emulator::Run<4>();
+template void Emulator::Run<8>();
+
+uint64_t Emulator::GetCycle() const noexcept { return cycle_count; }
+
+void Emulator::Replay(const uint64_t target) {
+  while (cycle_count < target) {
+    if (cpu.GetHalted()) {
+      throw std::runtime_error("Cycle " + std::to_string(target) +
+                               " is past the end of the program, which "
+                               "halts after cycle " +
+                               std::to_string(cycle_count));
+    }
+    Step(memory);
+  }
+}
+
+void Emulator::GotoCycle(const uint64_t cycle) {
+  if (!snapshots) {
+    throw std::runtime_error("Time travel is not enabled");
+  }
+  if (cycle < cycle_count) {
+    const Checkpoint* snapshot = snapshots->Find(cycle);
+    if (snapshot == nullptr) {
+      throw std::runtime_error(
+          "Cannot go back to cycle " + std::to_string(cycle) +
+          ": the oldest snapshot is at cycle " +
+          std::to_string(snapshots->Oldest()->cycle));
+    }
+    Restore(*snapshot);
+  }
+  Replay(cycle);
+}
+
+void Emulator::StepBack() {
+  if (cycle_count == 0) {
+    throw std::runtime_error("Cannot step back from cycle 0");
+  }
+  GotoCycle(cycle_count - 1);
+}
+
+std::optional<uint64_t> Emulator::RunBackToWrite(const uint8_t bank,
+                                                 const uint8_t addr) {
+  if (!snapshots) {
+    throw std::runtime_error("Time travel is not enabled");
+  }
+
+  // Replays the stretches between snapshots newest first, so the search
+  // stops at the first stretch holding a write
+  const uint64_t start = cycle_count;
+  std::optional<uint64_t> writer;
+  uint64_t stretch_end = start;
+  const Checkpoint* snapshot =
+      start > 0 ? snapshots->Find(start - 1) : nullptr;
+  while (snapshot != nullptr && !writer) {
+    Restore(*snapshot);
+    WriteFinder finder{{}, cycle_count, bank, addr, std::nullopt};
+    while (cycle_count < stretch_end) {
+      Step(memory, finder);
+    }
+    writer = finder.writer;
+
+    stretch_end = snapshot->cycle;
+    snapshot = stretch_end > 0 ? snapshots->Find(stretch_end - 1) : nullptr;
+  }
+
+  GotoCycle(writer ? *writer - 1 : start);
+  return writer;
+}
+
+const Cpu& Emulator::GetCpu() const noexcept { return cpu; }
+
+std::string Emulator::DescribePosition() const {
+  const auto address = static_cast<uint16_t>(
+      (memory.GetCurrentBank() << 8U) | cpu.GetPc());
+  const auto ir = static_cast<uint16_t>(
+      (memory.ReadByte(cpu.GetPc()) << 8U) |
+      memory.ReadByte(static_cast<uint8_t>(cpu.GetPc() + 1)));
+  return "Cycle " + std::to_string(cycle_count) + ": next instruction at " +
+         DescribeAddress(address, ir,
+                         symbols ? symbols->Lookup(address) : std::nullopt);
+}
+
+void Emulator::Report(const uint16_t halt_address) const {
+  std::vector<uint16_t> addresses;
+  for (std::size_t i = 0; i < profile.size(); ++i) {
+    if (profile[i] != 0) {
+      addresses.push_back(static_cast<uint16_t>(i));
+    }
+  }
+  const std::size_t hottest = std::min(addresses.size(), PROFILE_REPORT_SIZE);
+  std::ranges::partial_sort(addresses, addresses.begin() + hottest,
+                            [this](const uint16_t lhs, const uint16_t rhs) {
+                              return profile[lhs] > profile[rhs];
+                            });
+  addresses.resize(hottest);
+  addresses.push_back(halt_address);
+
+  const std::vector<std::optional<SourceLocation>> locations =
+      symbols ? symbols->Lookup(addresses)
+              : std::vector<std::optional<SourceLocation>>(addresses.size());
+
+  const auto instruction_at = [this](const uint16_t address) {
+    const auto bank = static_cast<uint8_t>(address >> 8U);
+    const auto addr = static_cast<uint8_t>(address);
+    return static_cast<uint16_t>(
+        (memory.ReadByte(bank, addr) << 8U) |
+        memory.ReadByte(bank, static_cast<uint8_t>(addr + 1)));
+  };
+
+  LOG_INFO("Halted at {}",
+           DescribeAddress(halt_address, instruction_at(halt_address),
+                           locations.back()));
+  LOG_INFO("Most executed instructions:");
+  for (std::size_t i = 0; i < hottest; ++i) {
+    LOG_INFO("  {:>8} x {}", profile[addresses[i]],
+             DescribeAddress(addresses[i], instruction_at(addresses[i]),
+                             locations[i]));
+  }
 }
@@ -0,0 +1,263 @@
+#include "dlw1_emulator/formatters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "spdlog/fmt/fmt.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,cppcoreguidelines-pro-bounds-constant-array-index,readability-magic-numbers)
+
+static constexpr std::array<std::array<char, 2>, 256> HEX = [] {
+  constexpr std::string_view DIGITS = "0123456789ABCDEF";
+  std::array<std::array<char, 2>, 256> table{};
+  for (std::size_t value = 0; value < table.size(); ++value) {
+    table[value] = {DIGITS[value >> 4U], DIGITS[value & 0xFU]};
+  }
+  return table;
+}();
+
+static constexpr std::array<std::array<char, 8>, 256> BITS = [] {
+  std::array<std::array<char, 8>, 256> table{};
+  for (std::size_t value = 0; value < table.size(); ++value) {
+    for (std::size_t bit = 0; bit < 8; ++bit) {
+      table[value][bit] = ((value >> (7 - bit)) & 1U) != 0 ? '1' : '0';
+    }
+  }
+  return table;
+}();
+
+static constexpr std::array<std::string_view, 4> MODE_NAMES{
+    "IMMEDIATE", "REGISTER", "RELATIVE", "NONE"};
+static constexpr std::array<std::string_view, 8> OPCODE_NAMES{
+    "ADD", "SUB", "LOAD", "STORE", "JUMP", "JUMPZ", "JUMPNZ", "JUMPN"};
+static constexpr std::array<std::string_view, 5> REGISTER_NAMES{
+    "A", "B", "C", "D", "NONE"};
+
+[[nodiscard]] static std::string_view Name(
+    const std::span<const std::string_view> names,
+    const std::size_t index) noexcept {
+  return index < names.size() ? names[index] : names.back();
+}
+
+// One line of a box, built on the stack
+class BoxLine {
+ private:
+  std::array<char, 48> data{};
+  std::size_t size = 0;
+
+ public:
+  BoxLine& Append(const std::string_view text) noexcept {
+    std::ranges::copy(text, data.begin() + size);
+    size += text.size();
+    return *this;
+  }
+
+  BoxLine& AppendHex(const uint8_t value) noexcept {
+    return Append({HEX[value].data(), 2});
+  }
+
+  BoxLine& AppendBits(const uint8_t value) noexcept {
+    return Append({BITS[value].data(), 8});
+  }
+
+  BoxLine& AppendDecimal(const int32_t value) noexcept {
+    size = std::to_chars(data.data() + size, data.data() + data.size(), value)
+               .ptr -
+           data.data();
+    return *this;
+  }
+
+  [[nodiscard]] std::string_view View() const noexcept {
+    return {data.data(), size};
+  }
+};
+
+[[nodiscard]] static fmt::format_context::iterator Write(
+    fmt::format_context::iterator out, const std::string_view text) {
+  return std::copy(text.begin(), text.end(), out);
+}
+
+// Lines framed by a border, padded to the longest one, without a newline
+// after the bottom border
+[[nodiscard]] static fmt::format_context::iterator WriteBox(
+    fmt::format_context::iterator out, const std::span<const BoxLine> lines) {
+  std::size_t max_length = 0;
+  for (const BoxLine& line : lines) {
+    max_length = std::max(line.View().size(), max_length);
+  }
+
+  out = Write(out, "+");
+  out = std::fill_n(out, max_length + 2, '-');
+  out = Write(out, "+\n");
+  for (const BoxLine& line : lines) {
+    out = Write(out, "| ");
+    out = Write(out, line.View());
+    out = std::fill_n(out, max_length - line.View().size(), ' ');
+    out = Write(out, " |\n");
+  }
+  out = Write(out, "+");
+  out = std::fill_n(out, max_length + 2, '-');
+  return Write(out, "+");
+}
+
+fmt::format_context::iterator fmt::formatter<Cpu>::format(
+    const Cpu& cpu, fmt::format_context& ctx) const {
+  std::array<BoxLine, 3> lines{};
+
+  lines[0]
+      .AppendBits(cpu.GetRegister(RegisterId::A))
+      .Append(" ")
+      .AppendBits(cpu.GetRegister(RegisterId::B))
+      .Append(" ")
+      .AppendBits(cpu.GetRegister(RegisterId::C))
+      .Append(" ")
+      .AppendBits(cpu.GetRegister(RegisterId::D));
+
+  lines[1].Append("PC: ").AppendDecimal(cpu.GetPc()).Append("   PSW: ");
+  if (cpu.GetPsw() == 0b01) {
+    lines[1].Append("ZERO");
+  } else if (cpu.GetPsw() == 0b10) {
+    lines[1].Append("NEGATIVE");
+  } else {
+    lines[1].Append("EMPTY");
+  }
+
+  lines[2]
+      .Append("IR: ")
+      .AppendBits(static_cast<uint8_t>(cpu.GetIr() >> 8U))
+      .AppendBits(static_cast<uint8_t>(cpu.GetIr()));
+
+  return WriteBox(ctx.out(), lines);
+}
+
+fmt::format_context::iterator fmt::formatter<Instruction>::format(
+    const Instruction& ins, fmt::format_context& ctx) const {
+  const auto reg = [](const RegisterId id) {
+    return Name(REGISTER_NAMES, static_cast<std::size_t>(id));
+  };
+
+  std::array<BoxLine, 6> lines{};
+  std::size_t count = 0;
+
+  const auto high = static_cast<uint8_t>(ins.raw >> 8U);
+  const auto low = static_cast<uint8_t>(ins.raw);
+  lines[count++]
+      .Append("Raw: 0x")
+      .AppendHex(high)
+      .AppendHex(low)
+      .Append(" 0b")
+      .AppendBits(high)
+      .AppendBits(low);
+  lines[count++].Append("Addressing Mode: ").Append(
+      Name(MODE_NAMES, static_cast<std::size_t>(ins.mode)));
+  lines[count++].Append("Opcode: ").Append(
+      Name(OPCODE_NAMES, static_cast<std::size_t>(ins.opcode)));
+
+  switch (ins.mode) {
+    case AddressingMode::REGISTER:
+      lines[count++].Append("Src1: ").Append(reg(ins.src));
+      lines[count++].Append("Src2: ").Append(reg(ins.src2));
+      lines[count++].Append("Dest: ").Append(reg(ins.dest));
+      break;
+    case AddressingMode::IMMEDIATE:
+      lines[count++].Append("Src: ").Append(reg(ins.src));
+      lines[count++].Append("Imm: ").AppendDecimal(ins.imm);
+      lines[count++].Append("Dest: ").Append(reg(ins.dest));
+      break;
+    case AddressingMode::RELATIVE:
+      if (ins.opcode == Opcode::STORE) {
+        lines[count++].Append("Src: ").Append(reg(ins.src2));
+      }
+      lines[count++].Append("Base: ").Append(reg(ins.src));
+      lines[count++].Append("Offset: ").AppendDecimal(
+          Cpu::CalculateOffset(ins.imm, ins.opcode));
+      if (ins.opcode == Opcode::LOAD) {
+        lines[count++].Append("Dest: ").Append(reg(ins.dest));
+      }
+      break;
+    default:
+      lines[count++].Append("Other addressing mode");
+  }
+
+  return WriteBox(ctx.out(), std::span{lines}.first(count));
+}
+
+fmt::format_context::iterator fmt::formatter<Memory>::format(
+    const Memory& memory, fmt::format_context& ctx) const {
+  constexpr std::size_t MATRIX_ROWS = 16;
+  constexpr std::size_t MATRIX_COLS = 16;
+  constexpr std::size_t TOTAL_WIDTH = (MATRIX_COLS * 3) + 1;
+
+  auto out = ctx.out();
+  for (std::size_t bank = 0; bank < memory.GetNumBanks(); ++bank) {
+    // Top border with bank number centered
+    BoxLine bank_header;
+    bank_header.Append(" Bank ")
+        .AppendDecimal(static_cast<int32_t>(bank))
+        .Append(" ");
+    const std::size_t dashes_total =
+        TOTAL_WIDTH > bank_header.View().size()
+            ? TOTAL_WIDTH - bank_header.View().size()
+            : 0;
+    const std::size_t left_dashes = dashes_total / 2;
+    out = Write(out, "+");
+    out = std::fill_n(out, left_dashes, '-');
+    out = Write(out, bank_header.View());
+    out = std::fill_n(out, dashes_total - left_dashes, '-');
+    out = Write(out, "+\n");
+
+    for (std::size_t row = 0; row < MATRIX_ROWS; ++row) {
+      // "| " + 16 "XX" separated by spaces + " |\n"
+      std::array<char, 2 + (MATRIX_COLS * 3) - 1 + 3> text{};
+      text[0] = '|';
+      text[1] = ' ';
+      for (std::size_t col = 0; col < MATRIX_COLS; ++col) {
+        const auto addr = static_cast<uint8_t>((row * MATRIX_COLS) + col);
+        const std::array<char, 2>& hex =
+            HEX[memory.ReadByte(static_cast<uint8_t>(bank), addr)];
+        text[2 + (col * 3)] = hex[0];
+        text[3 + (col * 3)] = hex[1];
+        text[4 + (col * 3)] = ' ';
+      }
+      text[text.size() - 2] = '|';
+      text[text.size() - 1] = '\n';
+      out = Write(out, {text.data(), text.size()});
+    }
+
+    // Bottom border
+    out = Write(out, "+");
+    out = std::fill_n(out, TOTAL_WIDTH, '-');
+    out = Write(out, "+\n");
+
+    // Spacing for following banks
+    if (bank < memory.GetNumBanks() - 1U) {
+      out = Write(out, "\n");
+    }
+  }
+  return out;
+}
+
+fmt::format_context::iterator fmt::formatter<MemoryWrite>::format(
+    const MemoryWrite& write, fmt::format_context& ctx) const {
+  BoxLine line;
+  line.Append("bank ")
+      .AppendDecimal(write.bank)
+      .Append(" address 0x")
+      .AppendHex(write.addr)
+      .Append(": 0x")
+      .AppendHex(write.old_value)
+      .Append(" -> 0x")
+      .AppendHex(write.new_value);
+  return Write(ctx.out(), line.View());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,cppcoreguidelines-pro-bounds-constant-array-index,readability-magic-numbers)
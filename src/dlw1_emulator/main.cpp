@@ -1,14 +1,23 @@
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <vector>
 
 #include "cxxopts.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
+#include "dlw1_emulator/checkpoint.hpp"
 #include "dlw1_emulator/config.hpp"
+#include "dlw1_emulator/debugger.hpp"
 #include "dlw1_emulator/emulator.hpp"
+#include "dlw1_emulator/formatters.hpp"
 #include "logger/logger.hpp"
 #include "spdlog/common.h"
 
@@ -33,13 +42,40 @@
   }
 }
 
+// Runs the emulator specialized for the bank count, for the counts that have
+// one
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+static void RunEmulator(Emulator& emulator, const uint8_t num_banks) {
+  switch (num_banks) {
+    case 1:
+      emulator.Run<1>();
+      break;
+    case 2:
+      emulator.Run<2>();
+      break;
+    case 4:
+      emulator.Run<4>();
+      break;
+    case 8:
+      emulator.Run<8>();
+      break;
+    default:
+      emulator.Run();
+      break;
+  }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
 // clang-tidy reports false positive
 // NOLINTNEXTLINE(bugprone-exception-escape)
 int main(int argc, char* argv[]) {
   try {
     cxxopts::Options options("DLW-1", "DLW-1 CPU Microarchitecture Emulator");
-    options.add_options()("f,file", "Path to the program file to execute",
-                          cxxopts::value<std::string>())(
+    options.add_options()(
+        "f,file",
+        "Path to the program file to execute (.s and .asm files are "
+        "assembled in memory)",
+        cxxopts::value<std::string>())(
         "b,banks",
         "Number of memory banks (default: " +
             std::to_string(Config::DEFAULT_NUM_BANKS) +
@@ -47,6 +83,44 @@ int main(int argc, char* argv[]) {
             std::to_string(Config::MAX_BANKS) + ")",
         cxxopts::value<uint8_t>()->default_value(
             std::to_string(Config::DEFAULT_NUM_BANKS)))(
+        "s,symbols",
+        "Path to the assembler's symbol map (default: program file with .dbg "
+        "extension, if present)",
+        cxxopts::value<std::string>())(
+        "p,protect",
+        "Accesses a bank allows, as BANK:FLAGS with FLAGS combining r, w and "
+        "x, e.g. 0:rx for read-only code (default: all)",
+        cxxopts::value<std::vector<std::string>>())(
+        "checkpoint-every",
+        "Write a checkpoint every N cycles, in the background (default: 0, "
+        "none)",
+        cxxopts::value<uint64_t>()->default_value("0"))(
+        "checkpoint-file",
+        "Path to write checkpoints to (default: program file with .ckpt "
+        "extension)",
+        cxxopts::value<std::string>())(
+        "r,resume", "Path to a checkpoint to resume the program from",
+        cxxopts::value<std::string>())(
+        "d,debug",
+        "Debug the program interactively instead of running it, with time "
+        "travel enabled")(
+        "t,time-travel",
+        "Keep a snapshot every N cycles in memory for time travel (default: "
+        "0, none, or " +
+            std::to_string(Config::DEFAULT_SNAPSHOT_INTERVAL) +
+            " with --goto-cycle or --back-to-write)",
+        cxxopts::value<uint64_t>()->default_value("0"))(
+        "snapshots",
+        "Number of most recent snapshots to keep (default: " +
+            std::to_string(Config::DEFAULT_SNAPSHOT_COUNT) + ")",
+        cxxopts::value<std::size_t>()->default_value(
+            std::to_string(Config::DEFAULT_SNAPSHOT_COUNT)))(
+        "goto-cycle", "After the run, go back to the state after cycle N",
+        cxxopts::value<uint64_t>())(
+        "back-to-write",
+        "After the run, go back to the last instruction that changed the "
+        "byte at BANK:ADDR",
+        cxxopts::value<std::string>())(
         "c,console-level", "Console log level [debug, info, warn, error, off]",
         cxxopts::value<std::string>()->default_value("info"))(
         "l,file-level", "File log level [debug, info, warn, error, off]",
@@ -112,11 +186,83 @@ int main(int argc, char* argv[]) {
                                e.what());
     }
 
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("symbols")) {
+      config.symbol_file_path = GetFilePath(parsed_options, "symbols");
+    } else if (!config.ProgramIsSource()) {
+      const std::filesystem::path sidecar =
+          std::filesystem::path(config.program_file_path)
+              .replace_extension(SYMBOL_MAP_EXTENSION);
+      std::error_code error_code;
+      if (std::filesystem::is_regular_file(sidecar, error_code)) {
+        config.symbol_file_path = sidecar.string();
+      }
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("protect")) {
+      for (const std::string& protection :
+           parsed_options["protect"].as<std::vector<std::string>>()) {
+        config.protections.push_back(Config::ParseProtection(protection));
+      }
+    }
+
+    try {
+      config.checkpoint_interval =
+          parsed_options["checkpoint-every"].as<uint64_t>();
+    } catch (const cxxopts::exceptions::exception& e) {
+      throw std::runtime_error(
+          std::string("Error reading checkpoint interval: ") + e.what());
+    }
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("checkpoint-file")) {
+      config.checkpoint_file_path =
+          GetFilePath(parsed_options, "checkpoint-file");
+    } else {
+      config.checkpoint_file_path =
+          std::filesystem::path(config.program_file_path)
+              .replace_extension(CHECKPOINT_EXTENSION)
+              .string();
+    }
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("resume")) {
+      config.resume_file_path = GetFilePath(parsed_options, "resume");
+    }
+
+    try {
+      config.snapshot_interval = parsed_options["time-travel"].as<uint64_t>();
+      config.snapshot_count = parsed_options["snapshots"].as<std::size_t>();
+      // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+      if (parsed_options.count("goto-cycle")) {
+        config.goto_cycle = parsed_options["goto-cycle"].as<uint64_t>();
+      }
+    } catch (const cxxopts::exceptions::exception& e) {
+      throw std::runtime_error(
+          std::string("Error reading time travel options: ") + e.what());
+    }
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("back-to-write")) {
+      config.back_to_write = Config::ParseAddress(
+          parsed_options["back-to-write"].as<std::string>());
+    }
+    const bool debug = parsed_options.count("debug") != 0;
+    if ((debug || config.goto_cycle || config.back_to_write) &&
+        config.snapshot_interval == 0) {
+      config.snapshot_interval = Config::DEFAULT_SNAPSHOT_INTERVAL;
+    }
+
     config.Validate();
 
     LOG_INFO("DLW-1 CPU Emulator Starting");
     LOG_INFO("Program file: {}", config.program_file_path);
     LOG_INFO("Memory banks: {}", config.num_banks);
+    if (!config.symbol_file_path.empty()) {
+      LOG_INFO("Symbol map: {}", config.symbol_file_path);
+    }
+    if (config.checkpoint_interval > 0) {
+      LOG_INFO("Checkpoint every {} cycles to: {}", config.checkpoint_interval,
+               config.checkpoint_file_path);
+    }
     LOG_INFO("Console log level: {}",
              spdlog::level::to_string_view(console_level));
     LOG_INFO("File log level: {}", spdlog::level::to_string_view(file_level));
@@ -127,10 +273,38 @@ int main(int argc, char* argv[]) {
     emulator.LoadProgram();
     LOG_INFO("Program loaded successfully");
 
+    if (debug) {
+      Debugger debugger{emulator};
+      debugger.Repl(std::cin, std::cout);
+      LOG_INFO("DLW-1 CPU Emulator Finished");
+      return EXIT_SUCCESS;
+    }
+
     LOG_INFO("Starting emulator execution...");
-    emulator.Run();
+    RunEmulator(emulator, config.num_banks);
     LOG_INFO("Emulator execution completed successfully");
 
+    if (config.goto_cycle) {
+      LOG_INFO("Going back to cycle {}...", *config.goto_cycle);
+      emulator.GotoCycle(*config.goto_cycle);
+      LOG_INFO("{}\n{}", emulator.DescribePosition(), emulator.GetCpu());
+    }
+    if (config.back_to_write) {
+      const auto [bank, addr] = *config.back_to_write;
+      LOG_INFO("Going back to the last write to bank {} address {}...", bank,
+               addr);
+      if (const std::optional<uint64_t> writer =
+              emulator.RunBackToWrite(bank, addr)) {
+        LOG_INFO("Bank {} address {} was last changed at cycle {}", bank,
+                 addr, *writer);
+      } else {
+        LOG_INFO("Bank {} address {} was not changed since the oldest "
+                 "snapshot",
+                 bank, addr);
+      }
+      LOG_INFO("{}\n{}", emulator.DescribePosition(), emulator.GetCpu());
+    }
+
     LOG_INFO("DLW-1 CPU Emulator Finished");
     return EXIT_SUCCESS;
   } catch (const std::exception& e) {
@@ -1,10 +1,31 @@
 #include "dlw1_emulator/memory.hpp"
 
+#include <algorithm>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
+
+Memory::Memory(const SharedBanks& shared_banks)
+    : curr_bank{0},
+      num_banks{static_cast<uint8_t>(shared_banks.size())},
+      pages(shared_banks.size(), &ZERO_PAGE),
+      banks(shared_banks.size()),
+      shared{shared_banks},
+      access(shared_banks.size(), BankAccess::ALL) {
+  for (std::size_t bank = 0; bank < shared.size(); ++bank) {
+    if (shared[bank] != nullptr) {
+      pages[bank] = shared[bank].get();
+    }
+  }
+}
 
 uint8_t Memory::GetCurrentBank() const noexcept { return curr_bank; }
 
@@ -12,14 +33,164 @@ uint8_t Memory::GetNumBanks() const noexcept { return num_banks; }
 
 uint8_t Memory::ReadByte(const uint8_t addr) const noexcept {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-  return banks[curr_bank][addr];
+  return (*pages[curr_bank])[addr];
+}
+
+uint8_t Memory::ReadByte(const uint8_t bank, const uint8_t addr) const noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  return (*pages[bank])[addr];
 }
 
 void Memory::SetCurrentBank(const uint8_t bank) noexcept { curr_bank = bank; }
 
+Memory::Bank& Memory::MakeWritable(const uint8_t bank) {
+  // A copy of the shared bank, or zeros
+  banks[bank] = std::make_unique<Bank>(*pages[bank]);
+  shared[bank].reset();
+  pages[bank] = banks[bank].get();
+  return *banks[bank];
+}
+
 void Memory::WriteByte(const uint8_t addr, const uint8_t val) noexcept {
+  Bank* bank = banks[curr_bank].get();
+  if (bank == nullptr) [[unlikely]] {
+    if ((access[curr_bank] & BankAccess::WRITE) == 0) {
+      if (!fault) {
+        fault = MemoryFault{curr_bank, addr, BankAccess::WRITE};
+      }
+      return;
+    }
+    // Writes that change nothing leave shared and zero banks in place
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    if ((*pages[curr_bank])[addr] == val) {
+      return;
+    }
+    if (!watched.empty() && watched[curr_bank] != 0) {
+      WriteWatched(addr, val);
+      return;
+    }
+    bank = &MakeWritable(curr_bank);
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  (*bank)[addr] = val;
+}
+
+void Memory::WriteWatched(const uint8_t addr, const uint8_t val) {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-  banks[curr_bank][addr] = val;
+  uint8_t& byte = MakeWritable(curr_bank)[addr];
+  if (!watch_hit && watchpoints[curr_bank].test(addr)) {
+    watch_hit = MemoryWrite{curr_bank, addr, byte, val};
+  }
+  byte = val;
+  shared[curr_bank] = std::move(banks[curr_bank]);
+}
+
+void Memory::LoadBytes(const uint16_t address,
+                       std::span<const uint8_t> bytes) {
+  std::size_t position = address;
+  while (!bytes.empty()) {
+    const auto bank = static_cast<uint8_t>(position / BANK_SIZE);
+    const std::size_t offset = position % BANK_SIZE;
+    const std::size_t count = std::min(bytes.size(), BANK_SIZE - offset);
+    const std::span<const uint8_t> chunk = bytes.first(count);
+    // Zero padding leaves untouched banks on the zero page
+    if (banks[bank] != nullptr || pages[bank] != &ZERO_PAGE ||
+        std::ranges::any_of(chunk,
+                            [](const uint8_t byte) { return byte != 0; })) {
+      Bank& page = banks[bank] != nullptr ? *banks[bank] : MakeWritable(bank);
+      std::ranges::copy(chunk, std::next(page.begin(),
+                                         static_cast<std::ptrdiff_t>(offset)));
+    }
+    bytes = bytes.subspan(count);
+    position += count;
+  }
+}
+
+uint8_t Memory::LoadByte(const uint8_t addr) noexcept {
+  if ((access[curr_bank] & BankAccess::READ) == 0) [[unlikely]] {
+    if (!fault) {
+      fault = MemoryFault{curr_bank, addr, BankAccess::READ};
+    }
+    return 0;
+  }
+  return ReadByte(addr);
+}
+
+void Memory::SetAccess(const uint8_t bank, const uint8_t flags) {
+  access[bank] = flags;
+  // Keep WriteByte's fast path for banks it may write to only
+  if ((flags & BankAccess::WRITE) == 0 && banks[bank] != nullptr) {
+    shared[bank] = std::move(banks[bank]);
+  }
+}
+
+uint8_t Memory::GetAccess(const uint8_t bank) const noexcept {
+  return access[bank];
+}
+
+const std::optional<MemoryFault>& Memory::GetFault() const noexcept {
+  return fault;
+}
+
+void Memory::ClearFault() noexcept { fault.reset(); }
+
+void Memory::Watch(const uint8_t bank, const uint8_t addr,
+                   const bool enabled) {
+  if (watchpoints.empty()) {
+    watchpoints.resize(num_banks);
+    watched.resize(num_banks);
+  }
+  watchpoints[bank].set(addr, enabled);
+  watched[bank] = watchpoints[bank].any() ? 1 : 0;
+  if (watched[bank] != 0 && banks[bank] != nullptr) {
+    shared[bank] = std::move(banks[bank]);
+  }
+}
+
+bool Memory::IsWatched(const uint8_t bank, const uint8_t addr) const noexcept {
+  return !watchpoints.empty() && watchpoints[bank].test(addr);
+}
+
+const std::optional<MemoryWrite>& Memory::GetWatchHit() const noexcept {
+  return watch_hit;
+}
+
+void Memory::ClearWatchHit() noexcept { watch_hit.reset(); }
+
+void Memory::Restore(const SharedBanks& shared_banks) {
+  shared = shared_banks;
+  for (std::size_t bank = 0; bank < shared.size(); ++bank) {
+    banks[bank].reset();
+    pages[bank] = shared[bank] != nullptr ? shared[bank].get() : &ZERO_PAGE;
+  }
+  fault.reset();
+  watch_hit.reset();
+}
+
+Memory::SharedBanks Memory::Share() {
+  for (std::size_t bank = 0; bank < banks.size(); ++bank) {
+    if (banks[bank] != nullptr) {
+      // The bank keeps its address, so `pages` stays valid
+      shared[bank] = std::move(banks[bank]);
+    }
+  }
+  return shared;
+}
+
+std::size_t Memory::GetAllocatedBanks() const noexcept {
+  return static_cast<std::size_t>(std::ranges::count_if(
+      banks, [](const std::unique_ptr<Bank>& bank) { return bank != nullptr; }));
+}
+
+std::size_t Memory::GetAllocatedBytes() const noexcept {
+  return (GetAllocatedBanks() * sizeof(Bank)) +
+         (pages.capacity() * sizeof(const Bank*)) +
+         (banks.capacity() * sizeof(std::unique_ptr<Bank>)) +
+         (shared.capacity() * sizeof(std::shared_ptr<const Bank>)) +
+         access.capacity() +
+         (watchpoints.capacity() * sizeof(std::bitset<BANK_SIZE>)) +
+         watched.capacity();
 }
 
 std::ostream& operator<<(std::ostream& os, const Memory& mem) {
@@ -46,10 +217,9 @@ std::ostream& operator<<(std::ostream& os, const Memory& mem) {
       os << "| ";
       for (std::size_t col = 0; col < matrix_cols; ++col) {
         auto addr = static_cast<uint8_t>((row * matrix_cols) + col);
-        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
         os << std::setw(2) << std::setfill('0') << std::uppercase << std::hex
-           << static_cast<int>(mem.banks[bank][addr]);
-        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+           << static_cast<int>(
+                  mem.ReadByte(static_cast<uint8_t>(bank), addr));
         if (col < matrix_cols - 1) {
           os << " ";
         }
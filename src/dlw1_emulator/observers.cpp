@@ -0,0 +1,22 @@
+#include "dlw1_emulator/observers.hpp"
+
+#include <array>
+
+#include "dlw1_emulator/disassembler.hpp"
+#include "dlw1_emulator/formatters.hpp"
+#include "logger/logger.hpp"
+
+void LoggingObserver::OnRetire(const Instruction& ins,
+                               const Cpu& cpu) noexcept {
+  std::array<char, Disassembler::MAX_TEXT_SIZE> text{};
+  LOG_INFO("Instruction: {}\n{}", Disassembler::Disassemble(ins.raw, text),
+           ins);
+  LOG_INFO("CPU State: \n{}", cpu);
+}
+
+void LoggingObserver::OnMemWrite(const MemoryWrite& write) noexcept {
+  // Only the bytes each cycle changes are logged between the full dumps
+  if (write.old_value != write.new_value) {
+    LOG_DEBUG("Cycle {}: Memory write: {}", cycle, write);
+  }
+}
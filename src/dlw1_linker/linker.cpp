@@ -0,0 +1,217 @@
+#include "dlw1_linker/linker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_assembler/encoder.hpp"
+#include "dlw1_assembler/mapped_file.hpp"
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_linker/sharded_map.hpp"
+#include "logger/logger.hpp"
+
+struct GlobalSymbol {
+  uint16_t address;
+  std::size_t input;  // Index of the defining input
+};
+
+// Runs body(0) ... body(count - 1) on up to `jobs` threads. If any call
+// throws, the remaining work is skipped and the exception of the lowest
+// failing index is rethrown, so errors do not depend on scheduling.
+static void ParallelFor(const std::size_t count, std::size_t jobs,
+                        const std::function<void(std::size_t)>& body) {
+  if (jobs == 0) {
+    jobs = std::max(1U, std::thread::hardware_concurrency());
+  }
+  const std::size_t workers = std::min(jobs, count);
+
+  std::atomic<std::size_t> next{0};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  std::size_t error_index = count;
+
+  const auto work = [&] {
+    for (std::size_t i = next++; i < count; i = next++) {
+      try {
+        body(i);
+      } catch (...) {
+        const std::scoped_lock lock{error_mutex};
+        if (i < error_index) {
+          error = std::current_exception();
+          error_index = i;
+        }
+        next = count;
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(workers > 0 ? workers - 1 : 0);
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+      threads.emplace_back(work);
+    }
+    work();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::vector<Linker::SectionBases> Linker::Place(
+    const std::span<const LinkInput> inputs, uint32_t& image_size) {
+  std::vector<SectionBases> bases(inputs.size());
+  uint32_t address = 0;
+
+  for (const Section section : {Section::TEXT, Section::DATA}) {
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      const std::size_t size = inputs[i].object.Contents(section).size();
+      if (size > 0 && size <= BANK_SIZE &&
+          (address % BANK_SIZE) + size > BANK_SIZE) {
+        address += BANK_SIZE - (address % BANK_SIZE);
+      }
+
+      bases[i].at(static_cast<std::size_t>(section)) = address;
+      address += static_cast<uint32_t>(size);
+      if (address > MAX_IMAGE_SIZE) {
+        throw std::runtime_error(inputs[i].name +
+                                 ": Linked program exceeds the 64KB "
+                                 "address space");
+      }
+    }
+  }
+
+  image_size = address;
+  return bases;
+}
+
+std::vector<LinkInput> Linker::Load(const std::vector<std::string>& file_paths,
+                                    const std::size_t jobs) {
+  std::vector<LinkInput> inputs(file_paths.size());
+  ParallelFor(file_paths.size(), jobs, [&](const std::size_t i) {
+    LinkInput& input = inputs[i];
+    input.name = file_paths[i];
+    try {
+      const InputFile file{input.name};
+      const std::string_view contents = file.View();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      const std::span<const uint8_t> bytes{
+          reinterpret_cast<const uint8_t*>(contents.data()), contents.size()};
+
+      if (ObjectFile::IsObject(bytes)) {
+        input.object = ObjectFile::Deserialize(bytes);
+      } else {
+        Assembler assembler;
+        input.object = assembler.AssembleObject(contents);
+      }
+    } catch (const std::exception& e) {
+      throw std::runtime_error(input.name + ": " + e.what());
+    }
+  });
+  return inputs;
+}
+
+std::vector<uint8_t> Linker::Link(const std::span<const LinkInput> inputs,
+                                  const std::size_t jobs) {
+  uint32_t image_size = 0;
+  const std::vector<SectionBases> bases = Place(inputs, image_size);
+
+  const auto address_of = [&bases](const std::size_t input,
+                                   const Section section,
+                                   const uint16_t offset) {
+    return static_cast<uint16_t>(
+        bases[input].at(static_cast<std::size_t>(section)) + offset);
+  };
+
+  // Publish every exported symbol before any relocation is resolved
+  ShardedMap<std::string, GlobalSymbol> globals;
+  ParallelFor(inputs.size(), jobs, [&](const std::size_t i) {
+    for (const ObjectSymbol& symbol : inputs[i].object.symbols) {
+      if (symbol.binding != SymbolBinding::GLOBAL) {
+        continue;
+      }
+      const auto [existing, inserted] = globals.TryEmplace(
+          symbol.name,
+          {.address = address_of(i, symbol.section, symbol.offset), .input = i});
+      if (!inserted) {
+        throw std::runtime_error("Duplicate global symbol '" + symbol.name +
+                                 "' in " + inputs[existing.input].name +
+                                 " and " + inputs[i].name);
+      }
+    }
+  });
+
+  // Inputs own disjoint ranges of the image, so they are patched in parallel
+  std::vector<uint8_t> image(image_size, 0);
+  ParallelFor(inputs.size(), jobs, [&](const std::size_t i) {
+    const ObjectFile& object = inputs[i].object;
+    for (const Section section : {Section::TEXT, Section::DATA}) {
+      std::ranges::copy(
+          object.Contents(section),
+          std::next(image.begin(),
+                    bases[i].at(static_cast<std::size_t>(section))));
+    }
+
+    for (const Relocation& relocation : object.relocations) {
+      const ObjectSymbol& symbol = object.symbols.at(relocation.symbol);
+      uint16_t target = 0;
+      if (symbol.binding == SymbolBinding::EXTERN) {
+        const std::optional<GlobalSymbol> global = globals.Find(symbol.name);
+        if (!global) {
+          throw std::runtime_error(inputs[i].name + ": Undefined symbol '" +
+                                   symbol.name + "'");
+        }
+        target = global->address;
+      } else {
+        target = address_of(i, symbol.section, symbol.offset);
+      }
+
+      const uint16_t address =
+          address_of(i, relocation.section, relocation.offset);
+      try {
+        Encoder::Relocate(
+            relocation.type, address, target,
+            std::span<uint8_t, Encoder::INSTRUCTION_SIZE>{
+                std::next(image.begin(), address), Encoder::INSTRUCTION_SIZE});
+      } catch (const std::exception& e) {
+        throw std::runtime_error(inputs[i].name + ": Reference to '" +
+                                 symbol.name + "': " + e.what());
+      }
+    }
+  });
+
+  LOG_DEBUG("Resolved {} global symbols", globals.Size());
+  return image;
+}
+
+void Linker::LinkFiles(const std::vector<std::string>& file_paths,
+                       const std::string& output_file_path,
+                       const std::size_t jobs) {
+  if (file_paths.empty()) {
+    throw std::runtime_error("No input files to link");
+  }
+
+  const std::vector<LinkInput> inputs = Load(file_paths, jobs);
+  const std::vector<uint8_t> image = Link(inputs, jobs);
+
+  OutputFile output_file{output_file_path, image.size()};
+  std::ranges::copy(image, output_file.Data().begin());
+  output_file.Commit();
+
+  LOG_INFO("Linked {} files into {} bytes: {}", inputs.size(), image.size(),
+           output_file_path);
+}
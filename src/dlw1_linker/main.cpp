@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cxxopts.hpp"
+#include "dlw1_linker/linker.hpp"
+#include "logger/logger.hpp"
+#include "spdlog/common.h"
+
+[[nodiscard]] static spdlog::level::level_enum ParseLogLevel(
+    const std::string& level_str, std::string_view option_name) {
+  try {
+    return Logger::StringToLevel(level_str);
+  } catch (const std::exception& e) {
+    throw std::runtime_error(std::string("Error reading ") +
+                             std::string(option_name) +
+                             " configuration: " + e.what());
+  }
+}
+
+// clang-tidy reports false positive
+// NOLINTNEXTLINE(bugprone-exception-escape)
+int main(int argc, char* argv[]) {
+  try {
+    cxxopts::Options options("dlw1-ld", "DLW-1 Linker");
+    options.positional_help("FILES...");
+    options.add_options()(
+        "input", "Object files (.o) or assembly files to link",
+        cxxopts::value<std::vector<std::string>>())(
+        "o,output", "Path to the output program file",
+        cxxopts::value<std::string>()->default_value("program.bin"))(
+        "j,jobs", "Number of threads to use (0 uses every core)",
+        cxxopts::value<std::size_t>()->default_value("0"))(
+        "c,console-level", "Console log level [debug, info, warn, error, off]",
+        cxxopts::value<std::string>()->default_value("info"))(
+        "l,file-level", "File log level [debug, info, warn, error, off]",
+        cxxopts::value<std::string>()->default_value("debug"))(
+        "version", "Print version information")("help",
+                                                "Print usage information");
+    options.parse_positional({"input"});
+
+    cxxopts::ParseResult parsed_options;
+    try {
+      parsed_options = options.parse(argc, argv);
+    } catch (const cxxopts::exceptions::exception& e) {
+      throw std::runtime_error("Failed to parse command line arguments: " +
+                               std::string(e.what()));
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("help")) {
+      std::cout << options.help() << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("version")) {
+      std::cout << PROJECT_VERSION << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    const spdlog::level::level_enum console_level = ParseLogLevel(
+        parsed_options["console-level"].as<std::string>(), "console-level");
+    const spdlog::level::level_enum file_level = ParseLogLevel(
+        parsed_options["file-level"].as<std::string>(), "file-level");
+    Logger::Init(console_level, file_level, APP_NAME);
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (!parsed_options.count("input")) {
+      throw std::runtime_error("No input files specified.");
+    }
+
+    Linker::LinkFiles(parsed_options["input"].as<std::vector<std::string>>(),
+                      parsed_options["output"].as<std::string>(),
+                      parsed_options["jobs"].as<std::size_t>());
+
+    return EXIT_SUCCESS;
+  } catch (const std::exception& e) {
+    const char* msg = "Error occurred";
+    if (Logger::GetLogger()) {
+      LOG_ERROR("{}: {}", msg, e.what());
+    } else {
+      std::cerr << "FATAL ERROR: " << msg << ": " << e.what() << '\n';
+    }
+    return EXIT_FAILURE;
+  } catch (...) {
+    const char* msg = "Unknown error occurred";
+    if (Logger::GetLogger()) {
+      LOG_ERROR("{}", msg);
+    } else {
+      std::cerr << "FATAL ERROR: " << msg << '\n';
+    }
+    return EXIT_FAILURE;
+  }
+}
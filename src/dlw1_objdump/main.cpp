@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "cxxopts.hpp"
+#include "dlw1_assembler/mapped_file.hpp"
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_assembler/program_image.hpp"
+#include "dlw1_assembler/symbol_map.hpp"
+#include "dlw1_emulator/disassembler.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// Label that starts at an address, in ascending address order
+using Label = std::pair<uint16_t, std::string_view>;
+
+// Collects text in a large buffer and writes it to stdout in chunks
+class Output {
+ private:
+  static constexpr std::size_t CAPACITY = std::size_t{1} << 20U;
+  std::vector<char> buffer;
+  std::size_t size = 0;
+
+ public:
+  Output() : buffer(CAPACITY) {}
+  ~Output() { Flush(); }
+
+  Output(const Output&) = delete;
+  Output& operator=(const Output&) = delete;
+  Output(Output&&) = delete;
+  Output& operator=(Output&&) = delete;
+
+  // Room for at least `count` more characters
+  std::span<char> Reserve(const std::size_t count) {
+    if (CAPACITY - size < count) {
+      Flush();
+    }
+    return std::span{buffer}.subspan(size);
+  }
+
+  void Commit(const std::size_t count) noexcept { size += count; }
+
+  void Write(const std::string_view text) {
+    const std::span<char> out = Reserve(text.size());
+    std::ranges::copy(text, out.begin());
+    Commit(text.size());
+  }
+
+  void Flush() noexcept {
+    if (size > 0) {
+      std::fwrite(buffer.data(), 1, size, stdout);
+      size = 0;
+    }
+  }
+};
+
+static constexpr std::string_view HEX_DIGITS = "0123456789ABCDEF";
+
+static void PutHex(const std::span<char> out, const std::size_t position,
+                   const uint8_t value) noexcept {
+  out[position] = HEX_DIGITS[value >> 4U];
+  out[position + 1] = HEX_DIGITS[value & 0xFU];
+}
+
+// Writes "  BB:AA  IRIR  text" lines for every instruction in `bytes`, which
+// start at image address `base`. A trailing odd byte is shown as data.
+static void DumpInstructions(const std::span<const uint8_t> bytes,
+                             const uint16_t base,
+                             const std::span<const Label> labels,
+                             Output& output) {
+  constexpr std::size_t PREFIX_SIZE = 15;  // "  BB:AA  IRIR  "
+  auto label = labels.begin();
+
+  for (std::size_t offset = 0; offset < bytes.size(); offset += 2) {
+    const auto address = static_cast<uint16_t>(base + offset);
+    for (; label != labels.end() && label->first <= address; ++label) {
+      if (label->first == address) {
+        output.Write(label->second);
+        output.Write(":\n");
+      }
+    }
+
+    const std::span<char> out =
+        output.Reserve(PREFIX_SIZE + Disassembler::MAX_TEXT_SIZE + 1);
+    out[0] = ' ';
+    out[1] = ' ';
+    PutHex(out, 2, static_cast<uint8_t>(address >> 8U));
+    out[4] = ':';
+    PutHex(out, 5, static_cast<uint8_t>(address));
+    out[7] = ' ';
+    out[8] = ' ';
+
+    std::size_t size = PREFIX_SIZE;
+    if (offset + 1 < bytes.size()) {
+      PutHex(out, 9, bytes[offset]);
+      PutHex(out, 11, bytes[offset + 1]);
+      out[13] = ' ';
+      out[14] = ' ';
+      const std::string_view text = Disassembler::Disassemble(
+          static_cast<uint16_t>((bytes[offset] << 8U) | bytes[offset + 1]),
+          out.subspan(PREFIX_SIZE).first<Disassembler::MAX_TEXT_SIZE>());
+      size += text.size();
+    } else {
+      PutHex(out, 9, bytes[offset]);
+      constexpr std::string_view BYTE = "    .byte";
+      std::ranges::copy(BYTE, out.subspan(11).begin());
+      size = 11 + BYTE.size();
+    }
+    out[size] = '\n';
+    output.Commit(size + 1);
+  }
+}
+
+// Writes "  BB:AA  XX XX ..." lines of up to 16 bytes each
+static void DumpData(const std::span<const uint8_t> bytes, Output& output) {
+  constexpr std::size_t ROW_SIZE = 16;
+  for (std::size_t offset = 0; offset < bytes.size(); offset += ROW_SIZE) {
+    const std::span<const uint8_t> row =
+        bytes.subspan(offset, std::min(ROW_SIZE, bytes.size() - offset));
+    const std::span<char> out = output.Reserve(9 + row.size() * 3);
+    out[0] = ' ';
+    out[1] = ' ';
+    PutHex(out, 2, static_cast<uint8_t>(offset >> 8U));
+    out[4] = ':';
+    PutHex(out, 5, static_cast<uint8_t>(offset));
+    out[7] = ' ';
+    std::size_t size = 8;
+    for (const uint8_t byte : row) {
+      out[size] = ' ';
+      PutHex(out, size + 1, byte);
+      size += 3;
+    }
+    out[size] = '\n';
+    output.Commit(size + 1);
+  }
+}
+
+// Labels of an image, taken from where each line's enclosing label changes
+[[nodiscard]] static std::vector<Label> ImageLabels(
+    const SymbolMap& symbols, const std::size_t image_size) {
+  std::vector<uint16_t> addresses;
+  addresses.reserve(image_size / 2);
+  for (std::size_t address = 0; address < image_size; address += 2) {
+    addresses.push_back(static_cast<uint16_t>(address));
+  }
+
+  std::vector<Label> labels;
+  std::string_view previous;
+  const std::vector<std::optional<SourceLocation>> locations =
+      symbols.Lookup(addresses);
+  for (std::size_t i = 0; i < addresses.size(); ++i) {
+    if (locations[i] && !locations[i]->label.empty() &&
+        locations[i]->label != previous) {
+      previous = locations[i]->label;
+      labels.emplace_back(addresses[i], previous);
+    }
+  }
+  return labels;
+}
+
+static void DumpObject(const ObjectFile& object, Output& output) {
+  std::vector<Label> labels;
+  for (const ObjectSymbol& symbol : object.symbols) {
+    if (symbol.binding != SymbolBinding::EXTERN &&
+        symbol.section == Section::TEXT) {
+      labels.emplace_back(symbol.offset, symbol.name);
+    }
+  }
+  std::ranges::stable_sort(labels, {}, &Label::first);
+
+  output.Write("Disassembly of section .text:\n");
+  DumpInstructions(object.Contents(Section::TEXT), 0, labels, output);
+
+  output.Write("Contents of section .data:\n");
+  DumpData(object.Contents(Section::DATA), output);
+}
+
+static void DumpImage(const ProgramImage& image,
+                      const std::span<const Label> labels, Output& output) {
+  const std::span<char> entry = output.Reserve(32);
+  std::ranges::copy(std::string_view{"Entry point: "}, entry.begin());
+  PutHex(entry, 13, static_cast<uint8_t>(image.entry >> 8U));
+  entry[15] = ':';
+  PutHex(entry, 16, static_cast<uint8_t>(image.entry));
+  entry[18] = '\n';
+  output.Commit(19);
+
+  for (const ImageSegment& segment : image.segments) {
+    const std::span<char> out = output.Reserve(32);
+    std::ranges::copy(std::string_view{"Segment "}, out.begin());
+    PutHex(out, 8, static_cast<uint8_t>(segment.address >> 8U));
+    out[10] = ':';
+    PutHex(out, 11, static_cast<uint8_t>(segment.address));
+    output.Commit(13);
+    output.Write((segment.flags & ImageSegment::READ_ONLY) != 0
+                     ? " (read-only):\n"
+                     : ":\n");
+    DumpInstructions(segment.bytes, segment.address, labels, output);
+  }
+}
+
+static void Dump(const std::string& file_path,
+                 const std::optional<std::string>& symbol_file_path,
+                 Output& output) {
+  const InputFile file{file_path};
+  const std::string_view view = file.View();
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const std::span bytes{reinterpret_cast<const uint8_t*>(view.data()),
+                        view.size()};
+
+  if (ObjectFile::IsObject(bytes)) {
+    DumpObject(ObjectFile::Deserialize(bytes), output);
+    return;
+  }
+
+  std::optional<SymbolMap> symbols;
+  if (symbol_file_path) {
+    symbols.emplace(*symbol_file_path);
+  } else if (file_path != STANDARD_STREAM_PATH) {
+    const std::filesystem::path sidecar =
+        std::filesystem::path(file_path).replace_extension(
+            SYMBOL_MAP_EXTENSION);
+    std::error_code error_code;
+    if (std::filesystem::is_regular_file(sidecar, error_code)) {
+      symbols.emplace(sidecar.string());
+    }
+  }
+
+  if (ProgramImage::IsImage(bytes)) {
+    const ProgramImage image = ProgramImage::Deserialize(bytes);
+    std::size_t image_size = 0;
+    for (const ImageSegment& segment : image.segments) {
+      image_size =
+          std::max(image_size, segment.address + segment.bytes.size());
+    }
+    const std::vector<Label> labels =
+        symbols ? ImageLabels(*symbols, image_size) : std::vector<Label>{};
+    DumpImage(image, labels, output);
+    return;
+  }
+
+  const std::vector<Label> labels =
+      symbols ? ImageLabels(*symbols, bytes.size()) : std::vector<Label>{};
+  DumpInstructions(bytes, 0, labels, output);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// clang-tidy reports false positive
+// NOLINTNEXTLINE(bugprone-exception-escape)
+int main(int argc, char* argv[]) {
+  try {
+    cxxopts::Options options("dlw1-objdump", "DLW-1 Disassembler");
+    options.positional_help("FILES...");
+    options.add_options()(
+        "input", "Program images or object files to disassemble (- for stdin)",
+        cxxopts::value<std::vector<std::string>>())(
+        "s,symbols",
+        "Path to the assembler's symbol map for a single image (default: "
+        "image with .dbg extension, if present)",
+        cxxopts::value<std::string>())(
+        "version", "Print version information")("help",
+                                                "Print usage information");
+    options.parse_positional({"input"});
+
+    cxxopts::ParseResult parsed_options;
+    try {
+      parsed_options = options.parse(argc, argv);
+    } catch (const cxxopts::exceptions::exception& e) {
+      throw std::runtime_error("Failed to parse command line arguments: " +
+                               std::string(e.what()));
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("help")) {
+      std::cout << options.help() << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("version")) {
+      std::cout << PROJECT_VERSION << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (!parsed_options.count("input")) {
+      throw std::runtime_error("No input files specified.");
+    }
+    const auto inputs = parsed_options["input"].as<std::vector<std::string>>();
+
+    std::optional<std::string> symbol_file_path;
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    if (parsed_options.count("symbols")) {
+      if (inputs.size() != 1) {
+        throw std::runtime_error(
+            "A symbol map can only be given for a single input file.");
+      }
+      symbol_file_path = parsed_options["symbols"].as<std::string>();
+    }
+
+    Output output;
+    for (const std::string& input : inputs) {
+      if (inputs.size() > 1) {
+        output.Write(input);
+        output.Write(":\n");
+      }
+      Dump(input, symbol_file_path, output);
+    }
+
+    return EXIT_SUCCESS;
+  } catch (const std::exception& e) {
+    std::cerr << "FATAL ERROR: Error occurred: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "FATAL ERROR: Unknown error occurred\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -40,7 +40,8 @@ std::shared_ptr<spdlog::logger>& Logger::GetLogger() noexcept { return logger; }
 
 void Logger::Init(spdlog::level::level_enum console_level,
                   spdlog::level::level_enum file_level,
-                  const std::string& initializer) {
+                  const std::string& initializer,
+                  const bool console_to_stderr) {
   if (initialized) {
     return;
   }
@@ -54,7 +55,12 @@ void Logger::Init(spdlog::level::level_enum console_level,
       std::filesystem::create_directories(log_dir);
     }
 
-    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    spdlog::sink_ptr console_sink;
+    if (console_to_stderr) {
+      console_sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+    } else {
+      console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    }
     console_sink->set_level(console_level);
 
     auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
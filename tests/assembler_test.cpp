@@ -0,0 +1,203 @@
+#include "dlw1_assembler/assembler.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dlw1_assembler/mapped_file.hpp"
+#include "gtest/gtest.h"
+#include "logger/logger.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static const std::string SAMPLE_PROGRAM =
+    "        .org 0x00\n"
+    "start:  load ra, #0x10      ; Load value at address 16 into register a\n"
+    "        load rb, #0x11      ; Load value at address 17 into register b\n"
+    "\n"
+    "loop:   sub ra, rb, ra      ; Register a = register a - register b\n"
+    "        jumpnz loop         ; Jump to loop label if not zero\n"
+    "\n"
+    "        store ra, #0x12     ; Store register a contents at address 18\n"
+    "        halt                ; End program\n"
+    "\n"
+    "        .org 0x10\n"
+    "        .byte 5             ; Counter start\n"
+    "        .byte 1             ; Decrement step\n";
+
+static const std::vector<uint8_t> SAMPLE_IMAGE{
+    0x10, 0x05, 0x11, 0x45, 0x00, 0x42, 0xFE, 0x1D, 0x12,
+    0x07, 0xFF, 0x08, 0x00, 0x00, 0x00, 0x00, 0x05, 0x01};
+
+class AssemblerEncodeTest
+    : public ::testing::TestWithParam<std::tuple<std::string,  // Source line
+                                                 uint16_t>> {};  // Expected IR
+
+TEST_P(AssemblerEncodeTest, EncodeInstruction) {
+  const auto& [source, expected_ir] = GetParam();
+
+  Assembler assembler;
+  const std::vector<uint8_t> image = assembler.Assemble(source);
+
+  ASSERT_EQ(image.size(), 2);
+  EXPECT_EQ(image[0], expected_ir >> 8U);
+  EXPECT_EQ(image[1], expected_ir & 0xFFU);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Instructions, AssemblerEncodeTest,
+    ::testing::Values(std::make_tuple("add ra, #4, rd", 0x04C1),
+                      std::make_tuple("ADD ra, rb, rc", 0x0240),
+                      std::make_tuple("sub ra, rb, ra", 0x0042),
+                      std::make_tuple("sub rb, #-1, rb", 0xFF53),
+                      std::make_tuple("load ra, #0x10", 0x1005),
+                      std::make_tuple("load rc, rb", 0x0214),
+                      std::make_tuple("load rd, (rb + #5)", 0x05D5),
+                      std::make_tuple("load ra, (rc - #1)", 0xFF25),
+                      std::make_tuple("bank #3", 0x03F4),
+                      std::make_tuple("store ra, #0x12", 0x1207),
+                      std::make_tuple("store rb, rc", 0x0216),
+                      std::make_tuple("store rc, (rb + #2)", 0x0297),
+                      std::make_tuple("mov rb, rd", 0x03D6),
+                      std::make_tuple("jump #0x20", 0x2009),
+                      std::make_tuple("jumpz rb", 0x001A),
+                      std::make_tuple("jumpn (-#4)", 0xFE1F),
+                      std::make_tuple("jumpnz (+#2)", 0x011D),
+                      std::make_tuple("halt", 0xFF08)));
+
+class AssemblerErrorTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(AssemblerErrorTest, RejectsInvalidSource) {
+  Assembler assembler;
+  EXPECT_THROW(static_cast<void>(assembler.Assemble(GetParam())),
+               std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Errors, AssemblerErrorTest,
+    ::testing::Values("jump nowhere", "a: halt\na: halt", "add ra, rb",
+                      "load rb, (ra + #1)", "load ra, #256", "bank rb",
+                      "foo ra", ".bogus 1", "halt ra", "mov ra, #1",
+                      ".byte 300", "load ra, @"));
+
+TEST(AssemblerTest, AssemblesSampleProgram) {
+  Assembler assembler;
+  EXPECT_EQ(assembler.Assemble(SAMPLE_PROGRAM), SAMPLE_IMAGE);
+}
+
+TEST(AssemblerTest, PlacesDataAfterText) {
+  Assembler assembler;
+  const std::vector<uint8_t> image = assembler.Assemble(
+      ".data\nvalue: .byte 7\n.text\nload ra, #value\nhalt\n");
+  EXPECT_EQ(image, (std::vector<uint8_t>{0x04, 0x05, 0xFF, 0x08, 0x07}));
+}
+
+TEST(AssemblerTest, ReassemblesOnlyChangedLines) {
+  Assembler assembler;
+  static_cast<void>(assembler.Assemble(SAMPLE_PROGRAM));
+  EXPECT_EQ(assembler.GetStats().parsed_lines, 11);  // Blank lines are shared
+
+  // Unchanged source parses and encodes nothing
+  EXPECT_EQ(assembler.Assemble(SAMPLE_PROGRAM), SAMPLE_IMAGE);
+  EXPECT_EQ(assembler.GetStats().parsed_lines, 0);
+  EXPECT_EQ(assembler.GetStats().encoded_lines, 0);
+  EXPECT_EQ(assembler.GetStats().changed_labels, 0);
+
+  // Inserting a line before the loop moves the label and its reference
+  std::string edited = SAMPLE_PROGRAM;
+  edited.insert(edited.find("loop:"), "        add rc, #1, rc\n");
+
+  Assembler fresh;
+  const std::vector<uint8_t> expected = fresh.Assemble(edited);
+  EXPECT_EQ(assembler.Assemble(edited), expected);
+  EXPECT_EQ(assembler.GetStats().parsed_lines, 1);
+  EXPECT_EQ(assembler.GetStats().changed_labels, 1);
+  EXPECT_EQ(assembler.GetStats().encoded_lines, 2);
+}
+
+TEST(AssemblerTest, EncodesLabelJumpsInEitherForm) {
+  const std::string source = "add ra, #1, ra\nloop: jumpnz loop\nhalt\n";
+  Assembler assembler;
+  EXPECT_EQ(assembler.Assemble(source),
+            (std::vector<uint8_t>{0x01, 0x01, 0xFF, 0x1D, 0xFF, 0x08}));
+
+  // Switching forms re-encodes the cached jump at the same size
+  assembler.SetPositionIndependent(false);
+  EXPECT_EQ(assembler.Assemble(source),
+            (std::vector<uint8_t>{0x01, 0x01, 0x02, 0x0D, 0xFF, 0x08}));
+  EXPECT_EQ(assembler.GetStats().encoded_lines, 1);
+
+  const ObjectFile object = assembler.AssembleObject(source);
+  ASSERT_EQ(object.relocations.size(), 1);
+  EXPECT_EQ(object.relocations[0].type, RelocationType::ABSOLUTE_8);
+}
+
+TEST(AssemblerTest, EncodesRepeatedLabelJumpsSeparately) {
+  const std::string source =
+      "loop: add ra, #1, ra\njump loop\nadd rb, #1, rb\njump loop\nhalt\n";
+  const std::vector<uint8_t> relative{0x01, 0x01, 0xFE, 0x19, 0x01,
+                                      0x51, 0xFC, 0x19, 0xFF, 0x08};
+  Assembler assembler;
+  EXPECT_EQ(assembler.Assemble(source), relative);
+  EXPECT_EQ(assembler.Assemble(source), relative);
+  EXPECT_EQ(assembler.GetStats().encoded_lines, 0);
+
+  // Both absolute jumps share a target and stay cached between runs
+  const std::vector<uint8_t> absolute{0x01, 0x01, 0x00, 0x09, 0x01,
+                                      0x51, 0x00, 0x09, 0xFF, 0x08};
+  assembler.SetPositionIndependent(false);
+  EXPECT_EQ(assembler.Assemble(source), absolute);
+  EXPECT_EQ(assembler.Assemble(source), absolute);
+  EXPECT_EQ(assembler.GetStats().encoded_lines, 0);
+
+  // Errors name the occurrence that failed, not the first one
+  try {
+    static_cast<void>(
+        assembler.Assemble("far: halt\njump far\n.org 0x100\njump far\n"));
+    FAIL() << "Expected a bank error";
+  } catch (const std::runtime_error& error) {
+    EXPECT_TRUE(std::string(error.what()).starts_with("Line 4:"));
+  }
+}
+
+// Assembles to a file and to stdout with logging on, then exits with
+// success if both images match
+[[noreturn]] static void StreamImage(const std::filesystem::path& directory) {
+  const std::string source_path = (directory / "program.s").string();
+  const std::string output_path = (directory / "program.bin").string();
+  std::filesystem::current_path(directory);  // Log file lands here
+  Logger::Init(spdlog::level::info, spdlog::level::off, "test", true);
+
+  Assembler assembler;
+  assembler.AssembleFile(source_path, output_path);
+  testing::internal::CaptureStdout();
+  assembler.AssembleFile(source_path, std::string(STANDARD_STREAM_PATH));
+  const std::string streamed = testing::internal::GetCapturedStdout();
+
+  std::ifstream output_file(output_path, std::ios::binary);
+  const std::string written{std::istreambuf_iterator<char>(output_file),
+                            std::istreambuf_iterator<char>()};
+  std::exit(streamed == written ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+TEST(AssemblerTest, WritesImageToStandardOutputWithoutLogLines) {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "dlw1_stdout_test";
+  std::filesystem::create_directories(directory);
+  std::ofstream(directory / "program.s", std::ios::binary) << SAMPLE_PROGRAM;
+
+  // Logging stays initialized for the rest of the process, so it runs in
+  // a child
+  EXPECT_EXIT(StreamImage(directory), testing::ExitedWithCode(EXIT_SUCCESS),
+              "");
+
+  std::filesystem::remove_all(directory);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
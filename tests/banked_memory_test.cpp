@@ -0,0 +1,61 @@
+#include "dlw1_emulator/banked_memory.hpp"
+
+#include <cstdint>
+
+#include "dlw1_emulator/config.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+TEST(BankedMemoryTest, WritesThroughToMemory) {
+  Memory memory{2};
+  BankedMemory<2> banked{memory};
+
+  // The first write copies the zero bank in Memory
+  banked.WriteByte(10, 1);
+  banked.SetCurrentBank(1);
+  banked.WriteByte(10, 2);
+  EXPECT_EQ(banked.LoadByte(10), 2);
+  EXPECT_EQ(memory.GetCurrentBank(), 1);
+  EXPECT_EQ(memory.ReadByte(0, 10), 1);
+  EXPECT_EQ(memory.ReadByte(1, 10), 2);
+  EXPECT_EQ(memory.GetAllocatedBanks(), 2);
+}
+
+TEST(BankedMemoryTest, SingleBankIgnoresBankSwitches) {
+  Memory memory{1};
+  BankedMemory<1> banked{memory};
+
+  banked.SetCurrentBank(3);
+  banked.WriteByte(200, 9);
+  EXPECT_EQ(banked.GetCurrentBank(), 0);
+  EXPECT_EQ(memory.GetCurrentBank(), 0);
+  EXPECT_EQ(memory.ReadByte(200), 9);
+}
+
+TEST(BankedMemoryTest, KeepsSharedBanksAfterSync) {
+  Memory memory{1};
+  BankedMemory<1> banked{memory};
+  banked.WriteByte(5, 1);
+
+  // Shared banks are immutable, so the next write copies the bank
+  const Memory::SharedBanks snapshot = memory.Share();
+  banked.Sync();
+  banked.WriteByte(5, 2);
+  EXPECT_EQ((*snapshot[0])[5], 1);
+  EXPECT_EQ(banked.ReadByte(5), 2);
+}
+
+TEST(BankedMemoryTest, LeavesProtectionToMemory) {
+  Memory memory{1};
+  memory.SetAccess(0, BankAccess::EXECUTE);
+  BankedMemory<1> banked{memory};
+
+  banked.WriteByte(5, 1);
+  EXPECT_EQ(banked.LoadByte(5), 0);
+  ASSERT_TRUE(memory.GetFault());
+  EXPECT_EQ(memory.GetFault()->access, BankAccess::WRITE);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -0,0 +1,111 @@
+#include "dlw1_emulator/checkpoint.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static const std::filesystem::path CHECKPOINT_PATH =
+    std::filesystem::temp_directory_path() / "dlw1_checkpoint_test.ckpt";
+
+TEST(CheckpointTest, RoundTripsStateThroughFile) {
+  Memory memory{3};
+  memory.SetCurrentBank(2);
+  memory.WriteByte(0x10, 0xAB);
+  memory.SetCurrentBank(0);
+  memory.WriteByte(0xFF, 0x01);
+
+  const Checkpoint saved{1234567890123,
+                         Cpu{{1, 2, 3, 4}, 0x0108, 6, 0b01, false}, 0,
+                         memory.Share()};
+  saved.Save(CHECKPOINT_PATH.string());
+  EXPECT_FALSE(std::filesystem::exists(CHECKPOINT_PATH.string() + ".tmp"));
+  // Bank 1 was never written, so only two banks are stored
+  EXPECT_EQ(std::filesystem::file_size(CHECKPOINT_PATH),
+            24 + 3 + (2 * BANK_SIZE));
+
+  const Checkpoint loaded = Checkpoint::Load(CHECKPOINT_PATH.string());
+  EXPECT_EQ(loaded.cycle, 1234567890123);
+  EXPECT_EQ(loaded.cpu.GetRegister(RegisterId::C), 3);
+  EXPECT_EQ(loaded.cpu.GetIr(), 0x0108);
+  EXPECT_EQ(loaded.cpu.GetPc(), 6);
+  EXPECT_EQ(loaded.cpu.GetPsw(), 0b01);
+  EXPECT_FALSE(loaded.cpu.GetHalted());
+  ASSERT_EQ(loaded.banks.size(), 3);
+  EXPECT_EQ(loaded.banks[1], nullptr);
+
+  // The resumed memory views the file until it writes a bank
+  Memory resumed{loaded.banks};
+  EXPECT_EQ(resumed.ReadByte(2, 0x10), 0xAB);
+  EXPECT_EQ(resumed.GetAllocatedBanks(), 0);
+  resumed.WriteByte(0xFF, 0x02);
+  EXPECT_EQ(resumed.GetAllocatedBanks(), 1);
+  EXPECT_EQ((*loaded.banks[0])[0xFF], 0x01);
+
+  std::filesystem::remove(CHECKPOINT_PATH);
+}
+
+TEST(CheckpointTest, RejectsCorruptCheckpoints) {
+  const Checkpoint saved{7, Cpu{}, 0, Memory{2}.Share()};
+  saved.Save(CHECKPOINT_PATH.string());
+  EXPECT_NO_THROW(
+      static_cast<void>(Checkpoint::Load(CHECKPOINT_PATH.string())));
+
+  // A bank flagged present whose contents are missing
+  std::fstream file{CHECKPOINT_PATH,
+                    std::ios::binary | std::ios::in | std::ios::out};
+  file.seekp(24);
+  file.put(1);
+  file.close();
+  EXPECT_THROW(static_cast<void>(Checkpoint::Load(CHECKPOINT_PATH.string())),
+               std::runtime_error);
+
+  std::ofstream(CHECKPOINT_PATH, std::ios::binary) << "DLWI";
+  EXPECT_THROW(static_cast<void>(Checkpoint::Load(CHECKPOINT_PATH.string())),
+               std::runtime_error);
+
+  std::filesystem::remove(CHECKPOINT_PATH);
+}
+
+TEST(CheckpointTest, WriterKeepsLatestCheckpoint) {
+  {
+    CheckpointWriter writer{CHECKPOINT_PATH.string()};
+    for (uint64_t cycle = 1; cycle <= 100; ++cycle) {
+      writer.Submit({cycle, Cpu{}, 0, Memory{1}.Share()});
+    }
+  }
+  EXPECT_EQ(Checkpoint::Load(CHECKPOINT_PATH.string()).cycle, 100);
+  EXPECT_FALSE(std::filesystem::exists(CHECKPOINT_PATH.string() + ".tmp"));
+
+  std::filesystem::remove(CHECKPOINT_PATH);
+}
+
+TEST(CheckpointTest, RingKeepsNewestCheckpoints) {
+  CheckpointRing ring{3};
+  EXPECT_EQ(ring.Find(100), nullptr);
+
+  for (uint64_t cycle = 0; cycle <= 50; cycle += 10) {
+    ring.Push({cycle, Cpu{}, 0, Memory{1}.Share()});
+  }
+  // Replaying an earlier stretch pushes states already held
+  ring.Push({40, Cpu{}, 0, Memory{1}.Share()});
+
+  EXPECT_EQ(ring.Oldest()->cycle, 30);
+  EXPECT_EQ(ring.Newest()->cycle, 50);
+  EXPECT_EQ(ring.Find(29), nullptr);
+  EXPECT_EQ(ring.Find(30)->cycle, 30);
+  EXPECT_EQ(ring.Find(49)->cycle, 40);
+  EXPECT_EQ(ring.Find(1000)->cycle, 50);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -0,0 +1,71 @@
+#include "dlw1_emulator/compile_time.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// resources/sample_program.s: counts register a down from 5 and stores it
+static constexpr std::array<uint8_t, 18> SAMPLE_PROGRAM{
+    0x10, 0x05,  // start:  load ra, #0x10
+    0x11, 0x45,  //         load rb, #0x11
+    0x00, 0x42,  // loop:   sub ra, rb, ra
+    0xFE, 0x1D,  //         jumpnz loop
+    0x12, 0x07,  //         store ra, #0x12
+    0xFF, 0x08,  //         halt
+    0x00, 0x00, 0x00, 0x00,
+    0x05,  // .byte 5
+    0x01,  // .byte 1
+};
+
+// Checked by the compiler; a failure fails the build
+static constexpr ProgramRun<1> SAMPLE_RUN = RunProgram(SAMPLE_PROGRAM, 100);
+static_assert(SAMPLE_RUN.cpu.GetRegister(RegisterId::A) == 0);
+static_assert(SAMPLE_RUN.cpu.GetRegister(RegisterId::B) == 1);
+static_assert(SAMPLE_RUN.memory.ReadByte(0x12) == 0);
+static_assert(SAMPLE_RUN.cycles == 14);
+
+static_assert([] {
+  Cpu cpu{{5, 10, 0, 0}, 0, 0, 0, false};
+  ArrayMemory<> memory;
+  cpu.Execute({AddressingMode::REGISTER, Opcode::ADD, RegisterId::A,
+               RegisterId::B, RegisterId::C, 0, 0},
+              memory);
+  cpu.Execute({AddressingMode::IMMEDIATE, Opcode::STORE, RegisterId::C,
+               RegisterId::NONE, RegisterId::NONE, 100, 0},
+              memory);
+  return memory.ReadByte(100);
+}() == 15);
+
+TEST(CompileTimeTest, RunsAssembledProgramsAtRunTime) {
+  Assembler assembler;
+  const std::vector<uint8_t> image = assembler.Assemble(
+      "        load ra, #0x10\n"
+      "        bank #1\n"
+      "        .org 0x10\n"
+      "        .byte 42\n"
+      "        .org 0x104          ; Execution continues in bank 1\n"
+      "        store ra, #0x20\n"
+      "        halt\n");
+
+  const ProgramRun<2> run = RunProgram<2>(image, 100);
+  EXPECT_EQ(run.cpu.GetRegister(RegisterId::A), 42);
+  EXPECT_EQ(run.memory.GetCurrentBank(), 1);
+  EXPECT_EQ(run.memory.ReadByte(1, 0x20), 42);
+  EXPECT_EQ(run.cycles, 4);
+}
+
+TEST(CompileTimeTest, StopsAtCycleBudget) {
+  // loop: jump loop
+  constexpr std::array<uint8_t, 2> loop{0xFF, 0x19};
+  EXPECT_THROW(static_cast<void>(RunProgram(loop, 1000)), std::runtime_error);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "dlw1_emulator/compile_time.hpp"
 #include "dlw1_emulator/instruction.hpp"
 #include "dlw1_emulator/memory.hpp"
 #include "gtest/gtest.h"
@@ -148,6 +149,14 @@ INSTANTIATE_TEST_SUITE_P(
                         Opcode::JUMPN, RegisterId::NONE, RegisterId::NONE,
                         RegisterId::NONE, 255)));
 
+TEST(CpuDecodeTableTest, MatchesFieldDecoderForAllEncodings) {
+  for (std::size_t raw = 0; raw < NUM_ENCODINGS; ++raw) {
+    const auto ir = static_cast<uint16_t>(raw);
+    const Cpu cpu{{0, 0, 0, 0}, ir, 0, 0, false};
+    ASSERT_EQ(cpu.Decode(), Cpu::DecodeFields(ir)) << "IR " << raw;
+  }
+}
+
 class CpuExecuteTest
     : public ::testing::TestWithParam<std::tuple<
           std::array<uint8_t, 4>,                         // Initial registers
@@ -404,6 +413,82 @@ TEST(CpuFetchTest, FetchInstruction) {
   EXPECT_EQ(cpu.GetPc(), 2);
 }
 
+TEST(CpuStatusWordTest, KeepsConstructedStatusWord) {
+  for (const uint8_t psw : {0b00, 0b01, 0b10}) {
+    const Cpu cpu{{0, 0, 0, 0}, 0, 0, psw, false};
+    EXPECT_EQ(cpu.GetPsw(), psw);
+  }
+}
+
+static std::tuple<std::array<uint8_t, 4>, uint16_t, uint8_t, uint8_t, bool>
+State(const Cpu& cpu) {
+  return {{cpu.GetRegister(RegisterId::A), cpu.GetRegister(RegisterId::B),
+           cpu.GetRegister(RegisterId::C), cpu.GetRegister(RegisterId::D)},
+          cpu.GetIr(),
+          cpu.GetPc(),
+          cpu.GetPsw(),
+          cpu.GetHalted()};
+}
+
+// Fetches the pair at `addr` and runs it fused, and checks the result against
+// running it one instruction at a time. Returns whether it was fused.
+static bool ExpectFusedMatches(const uint16_t first, const uint16_t second,
+                               const uint8_t addr) {
+  static const ArrayMemory<> data = [] {
+    ArrayMemory<> memory;
+    for (std::size_t i = 0; i < BANK_SIZE; ++i) {
+      memory.WriteByte(static_cast<uint8_t>(i), static_cast<uint8_t>(i * 37));
+    }
+    return memory;
+  }();
+  ArrayMemory<> memory = data;
+  memory.WriteByte(addr, static_cast<uint8_t>(first >> 8U));
+  memory.WriteByte(addr + 1, static_cast<uint8_t>(first));
+  memory.WriteByte(addr + 2, static_cast<uint8_t>(second >> 8U));
+  memory.WriteByte(addr + 3, static_cast<uint8_t>(second));
+
+  Cpu fused{{0, 1, 0x7F, 0x80}, 0, addr, 0, false};
+  fused.Fetch(memory);
+  Cpu expected = fused;
+  const bool was_fused = fused.ExecuteFused(fused.Decode(), memory);
+  if (was_fused) {
+    expected.Execute(expected.Decode(), memory);
+    expected.Fetch(memory);
+    expected.Execute(expected.Decode(), memory);
+  }
+  EXPECT_EQ(State(fused), State(expected))
+      << "Pair " << first << ", " << second << " at " << int{addr};
+  return was_fused;
+}
+
+TEST(CpuExecuteFusedTest, MatchesExecutingEachInstruction) {
+  // sub ra, rb, ra; jumpnz (-#4); load ra, #0x10; store ra, #0x12; halt
+  constexpr std::array<uint16_t, 5> samples{0x0042, 0xFE1D, 0x1005, 0x1207,
+                                            0xFF08};
+  std::size_t fused = 0;
+  for (std::size_t raw = 0; raw < NUM_ENCODINGS; ++raw) {
+    for (const uint16_t sample : samples) {
+      // The second pair wraps around to the start of the bank
+      for (const uint8_t addr : {0x20, 0xFE}) {
+        fused += ExpectFusedMatches(static_cast<uint16_t>(raw), sample, addr);
+        fused += ExpectFusedMatches(sample, static_cast<uint16_t>(raw), addr);
+      }
+    }
+  }
+  EXPECT_GT(fused, 0);
+}
+
+TEST(CpuExecuteFusedTest, RunsOnlyFusablePairs) {
+  // sub ra, rb, ra followed by jumpnz (-#4) or by a store
+  EXPECT_TRUE(ExpectFusedMatches(0x0042, 0xFE1D, 0x20));
+  EXPECT_FALSE(ExpectFusedMatches(0x0042, 0x1207, 0x20));
+  // load ra, #0x10 followed by sub ra, rb, ra or by halt
+  EXPECT_TRUE(ExpectFusedMatches(0x1005, 0x0042, 0x20));
+  EXPECT_FALSE(ExpectFusedMatches(0x1005, 0xFF08, 0x20));
+  // The next fetch from address 255 halts
+  EXPECT_FALSE(ExpectFusedMatches(0x0042, 0xFE1D, 0xFD));
+}
+
 class CpuCalculateLoadStoreOffsetTest
     : public ::testing::TestWithParam<Opcode> {};
 
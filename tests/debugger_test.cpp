@@ -0,0 +1,81 @@
+#include "dlw1_emulator/debugger.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <sstream>
+#include <string>
+
+#include "dlw1_emulator/config.hpp"
+#include "dlw1_emulator/emulator.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// Counts down from 3, storing every value at address 0x12
+static const std::string PROGRAM =
+    "        load ra, #0x10\n"
+    "        load rb, #0x11\n"
+    "loop:   sub ra, rb, ra\n"
+    "        store ra, #0x12\n"
+    "        jumpnz loop\n"
+    "        halt\n"
+    "        .org 0x10\n"
+    "        .byte 3\n"
+    "        .byte 1\n";
+
+static std::string Debug(const std::string& commands) {
+  const std::filesystem::path source_path =
+      std::filesystem::temp_directory_path() / "dlw1_debugger_test.s";
+  std::ofstream(source_path, std::ios::binary) << PROGRAM;
+
+  Config config{};
+  config.num_banks = 1;
+  config.program_file_path = source_path.string();
+  config.snapshot_interval = Config::DEFAULT_SNAPSHOT_INTERVAL;
+  Emulator emulator{config};
+  emulator.LoadProgram();
+
+  std::istringstream input{commands};
+  std::ostringstream output;
+  Debugger{emulator}.Repl(input, output);
+  std::filesystem::remove(source_path);
+  return output.str();
+}
+
+TEST(DebuggerTest, StopsAtBreakpointsOnEveryPass) {
+  const std::string output = Debug("b 0:6\nc\nc\ncontinue\n");
+  EXPECT_NE(output.find("Breakpoint\nCycle 3: next instruction at bank 0 "
+                        "address 6 ("),
+            std::string::npos);
+  EXPECT_NE(output.find("dlw1_debugger_test.s:4 store ra, #0x12)"),
+            std::string::npos);
+  // The jump back enters a new block, where the breakpoint is found again
+  EXPECT_NE(output.find("Breakpoint\nCycle 6:"), std::string::npos);
+  EXPECT_NE(output.find("Breakpoint\nCycle 9:"), std::string::npos);
+}
+
+TEST(DebuggerTest, StopsAtBreakpointsAfterSteppingOverOne) {
+  // Straight-line execution passes the odd address without stopping there
+  const std::string output = Debug("b 0:3\nb 0:6\nc\n");
+  EXPECT_NE(output.find("Breakpoint\nCycle 3: next instruction at bank 0 "
+                        "address 6 ("),
+            std::string::npos);
+}
+
+TEST(DebuggerTest, StopsAfterWatchedWritesAndTravelsBack) {
+  const std::string output =
+      Debug("watch 0:0x12\nc\nc\nback-to-write 0:0x12\nx 0:0x10 3\nq\ns\n");
+  EXPECT_NE(output.find("Watchpoint: bank 0 address 0x12: 0x00 -> 0x02\n"
+                        "Cycle 4:"),
+            std::string::npos);
+  EXPECT_NE(output.find("0x02 -> 0x01\nCycle 7:"), std::string::npos);
+  // Just before the store that wrote 1, the byte still holds 2
+  EXPECT_NE(output.find("Last changed at cycle 7\nCycle 6:"),
+            std::string::npos);
+  EXPECT_NE(output.find("0:0x10  03 01 02\n"), std::string::npos);
+  // Commands after quit are not run
+  EXPECT_EQ(output.find("Cycle 7: next"), output.rfind("Cycle 7: next"));
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
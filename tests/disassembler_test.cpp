@@ -0,0 +1,84 @@
+#include "dlw1_emulator/disassembler.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+[[nodiscard]] static std::string Disassemble(const uint16_t ir) {
+  std::array<char, Disassembler::MAX_TEXT_SIZE> buffer{};
+  return std::string(Disassembler::Disassemble(ir, buffer));
+}
+
+[[nodiscard]] static Instruction Decode(const uint16_t ir) {
+  const Cpu cpu{{}, ir, 0, 0, false};
+  return cpu.Decode();
+}
+
+[[nodiscard]] static bool IsHalt(const Instruction& ins) {
+  return ins.opcode >= Opcode::JUMP && ins.mode == AddressingMode::NONE;
+}
+
+class DisassemblerTest
+    : public ::testing::TestWithParam<std::tuple<uint16_t, std::string>> {};
+
+TEST_P(DisassemblerTest, WritesCanonicalText) {
+  const auto& [ir, expected_text] = GetParam();
+  EXPECT_EQ(Disassemble(ir), expected_text);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Instructions, DisassemblerTest,
+    ::testing::Values(std::make_tuple(0x04C1, "add ra, #4, rd"),
+                      std::make_tuple(0x0240, "add ra, rb, rc"),
+                      std::make_tuple(0xFF53, "sub rb, #255, rb"),
+                      std::make_tuple(0x1005, "load ra, #0x10"),
+                      std::make_tuple(0x0214, "load rc, rb"),
+                      std::make_tuple(0x05D5, "load rd, (rb + #5)"),
+                      std::make_tuple(0xFF25, "load ra, (rc - #1)"),
+                      std::make_tuple(0x03F4, "bank #3"),
+                      std::make_tuple(0x0216, "store rb, rc"),
+                      std::make_tuple(0x8097, "store rc, (rb - #128)"),
+                      std::make_tuple(0x03D6, "mov rb, rd"),
+                      std::make_tuple(0x2009, "jump #0x20"),
+                      std::make_tuple(0x001A, "jumpz rb"),
+                      std::make_tuple(0xFE1F, "jumpn (-#4)"),
+                      std::make_tuple(0x011D, "jumpnz (+#2)"),
+                      std::make_tuple(0xFF08, "halt"),
+                      std::make_tuple(0x00C8, "halt")));
+
+// Every IR disassembles to text the assembler turns back into an
+// instruction the CPU decodes identically
+TEST(DisassemblerTest, RoundTripsEveryInstruction) {
+  Assembler assembler;
+  for (uint32_t ir = 0; ir <= UINT16_MAX; ++ir) {
+    const std::string text = Disassemble(static_cast<uint16_t>(ir));
+    const std::vector<uint8_t> image = assembler.Assemble(text);
+    ASSERT_EQ(image.size(), 2) << text;
+
+    const Instruction original = Decode(static_cast<uint16_t>(ir));
+    const Instruction reassembled =
+        Decode(static_cast<uint16_t>((image[0] << 8U) | image[1]));
+    if (IsHalt(original)) {
+      EXPECT_TRUE(IsHalt(reassembled)) << text;
+      continue;
+    }
+    ASSERT_EQ(reassembled.opcode, original.opcode) << text;
+    ASSERT_EQ(reassembled.mode, original.mode) << text;
+    ASSERT_EQ(reassembled.src, original.src) << text;
+    ASSERT_EQ(reassembled.src2, original.src2) << text;
+    ASSERT_EQ(reassembled.dest, original.dest) << text;
+    ASSERT_EQ(reassembled.imm, original.imm) << text;
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
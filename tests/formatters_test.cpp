@@ -0,0 +1,48 @@
+#include "dlw1_emulator/formatters.hpp"
+
+#include <cstdint>
+
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/helpers.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "gtest/gtest.h"
+#include "spdlog/fmt/fmt.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+TEST(FormattersTest, FormatsCpuLikeStream) {
+  for (const uint8_t psw : {0b00, 0b01, 0b10}) {
+    const Cpu cpu{{0x00, 0x5A, 0x80, 0xFF}, 0xC3A5, 7, psw, false};
+    EXPECT_EQ(fmt::format("{}", cpu), to_string(cpu));
+  }
+  const Cpu cpu{{1, 2, 3, 4}, 0x0001, 255, 0, false};
+  EXPECT_EQ(fmt::format("{}", cpu), to_string(cpu));
+}
+
+TEST(FormattersTest, FormatsEveryInstructionLikeStream) {
+  for (uint32_t ir = 0; ir <= UINT16_MAX; ++ir) {
+    const Cpu cpu{{}, static_cast<uint16_t>(ir), 0, 0, false};
+    const Instruction ins = cpu.Decode();
+    ASSERT_EQ(fmt::format("{}", ins), to_string(ins)) << ir;
+  }
+}
+
+TEST(FormattersTest, FormatsMemoryLikeStream) {
+  Memory memory(12);
+  for (uint8_t bank = 0; bank < 12; ++bank) {
+    memory.SetCurrentBank(bank);
+    for (uint32_t addr = 0; addr <= UINT8_MAX; addr += 3) {
+      memory.WriteByte(static_cast<uint8_t>(addr),
+                       static_cast<uint8_t>(addr * (bank + 1)));
+    }
+  }
+  EXPECT_EQ(fmt::format("{}", memory), to_string(memory));
+}
+
+TEST(FormattersTest, FormatsMemoryWrite) {
+  EXPECT_EQ(fmt::format("{}", MemoryWrite{12, 0x2A, 0x00, 0xF5}),
+            "bank 12 address 0x2A: 0x00 -> 0xF5");
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
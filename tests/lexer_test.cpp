@@ -6,9 +6,16 @@
 #include <utility>
 #include <vector>
 
+#include "dlw1_assembler/keywords.hpp"
 #include "dlw1_assembler/token.hpp"
 #include "gtest/gtest.h"
 
+// The keyword table is generated at compile time, so it can be checked there
+static_assert(Keywords::Lookup("jumpnz") == TokenType::JUMPNZ);
+static_assert(Keywords::Lookup("RD") == TokenType::REGISTER);
+static_assert(!Keywords::Lookup("loop").has_value());
+static_assert(Keywords::Lookup(".Global") == TokenType::DIRECTIVE_GLOBAL);
+
 class LexerTokenizeTest : public ::testing::TestWithParam<
                               std::tuple<std::string, std::vector<Token>>> {};
 
@@ -208,9 +215,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(
             "load ra, #123",
             std::vector<Token>{
-                {.text = "load",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 0},
+                {.text = "load", .type = TokenType::LOAD, .line_number = 0},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 0},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 0},
                 {.text = "#", .type = TokenType::HASH, .line_number = 0},
@@ -232,7 +237,7 @@ INSTANTIATE_TEST_SUITE_P(
 
         std::make_tuple(".org 0x100",
                         std::vector<Token>{{.text = ".org",
-                                            .type = TokenType::DIRECTIVE,
+                                            .type = TokenType::DIRECTIVE_ORG,
                                             .line_number = 0},
                                            {.text = "0x100",
                                             .type = TokenType::NUMBER,
@@ -266,9 +271,7 @@ INSTANTIATE_TEST_SUITE_P(
                  .type = TokenType::IDENTIFIER,
                  .line_number = 0},
                 {.text = ":", .type = TokenType::COLON, .line_number = 0},
-                {.text = "load",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 0},
+                {.text = "load", .type = TokenType::LOAD, .line_number = 0},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 0},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 0},
                 {.text = "#", .type = TokenType::HASH, .line_number = 0},
@@ -285,7 +288,7 @@ INSTANTIATE_TEST_SUITE_P(
                  .line_number = 0},
                 {.text = ":", .type = TokenType::COLON, .line_number = 0},
                 {.text = ".byte",
-                 .type = TokenType::DIRECTIVE,
+                 .type = TokenType::DIRECTIVE_BYTE,
                  .line_number = 0},
                 {.text = "0xFF", .type = TokenType::NUMBER, .line_number = 0},
                 {.text = "",
@@ -299,9 +302,7 @@ INSTANTIATE_TEST_SUITE_P(
                  .type = TokenType::IDENTIFIER,
                  .line_number = 0},
                 {.text = ":", .type = TokenType::COLON, .line_number = 0},
-                {.text = "sub",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 0},
+                {.text = "sub", .type = TokenType::SUB, .line_number = 0},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 0},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 0},
                 {.text = "rb", .type = TokenType::REGISTER, .line_number = 0},
@@ -327,16 +328,12 @@ INSTANTIATE_TEST_SUITE_P(
                  .type = TokenType::IDENTIFIER,
                  .line_number = 0},
                 {.text = ":", .type = TokenType::COLON, .line_number = 0},
-                {.text = "load",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 1},
+                {.text = "load", .type = TokenType::LOAD, .line_number = 1},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 1},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 1},
                 {.text = "#", .type = TokenType::HASH, .line_number = 1},
                 {.text = "10", .type = TokenType::NUMBER, .line_number = 1},
-                {.text = "halt",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 2},
+                {.text = "halt", .type = TokenType::HALT, .line_number = 2},
                 {.text = "",
                  .type = TokenType::END_OF_FILE,
                  .line_number = 3}}),
@@ -344,9 +341,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(
             "  \n\n\tload ra, #1\n  ",
             std::vector<Token>{
-                {.text = "load",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 2},
+                {.text = "load", .type = TokenType::LOAD, .line_number = 2},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 2},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 2},
                 {.text = "#", .type = TokenType::HASH, .line_number = 2},
@@ -358,9 +353,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(
             "; This is a comment\nload ra, #1",
             std::vector<Token>{
-                {.text = "load",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 1},
+                {.text = "load", .type = TokenType::LOAD, .line_number = 1},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 1},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 1},
                 {.text = "#", .type = TokenType::HASH, .line_number = 1},
@@ -372,9 +365,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(
             "load ra, 0b1101",
             std::vector<Token>{
-                {.text = "load",
-                 .type = TokenType::IDENTIFIER,
-                 .line_number = 0},
+                {.text = "load", .type = TokenType::LOAD, .line_number = 0},
                 {.text = "ra", .type = TokenType::REGISTER, .line_number = 0},
                 {.text = ",", .type = TokenType::COMMA, .line_number = 0},
                 {.text = "0b1101", .type = TokenType::NUMBER, .line_number = 0},
@@ -386,7 +377,7 @@ INSTANTIATE_TEST_SUITE_P(
             ".data var1, var2, #123",
             std::vector<Token>{
                 {.text = ".data",
-                 .type = TokenType::DIRECTIVE,
+                 .type = TokenType::DIRECTIVE_DATA,
                  .line_number = 0},
                 {.text = "var1",
                  .type = TokenType::IDENTIFIER,
@@ -401,3 +392,110 @@ INSTANTIATE_TEST_SUITE_P(
                 {.text = "",
                  .type = TokenType::END_OF_FILE,
                  .line_number = 1}})));
+
+INSTANTIATE_TEST_SUITE_P(
+    Keywords, LexerTokenizeTest,
+    ::testing::Values(
+        std::make_tuple("JUMPNZ",
+                        std::vector<Token>{{.text = "JUMPNZ",
+                                            .type = TokenType::JUMPNZ,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple("JumpZ",
+                        std::vector<Token>{{.text = "JumpZ",
+                                            .type = TokenType::JUMPZ,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple("jumpn",
+                        std::vector<Token>{{.text = "jumpn",
+                                            .type = TokenType::JUMPN,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple("jumpnzz",
+                        std::vector<Token>{{.text = "jumpnzz",
+                                            .type = TokenType::IDENTIFIER,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple("adds",
+                        std::vector<Token>{{.text = "adds",
+                                            .type = TokenType::IDENTIFIER,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple("Store",
+                        std::vector<Token>{{.text = "Store",
+                                            .type = TokenType::STORE,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple(".WORD",
+                        std::vector<Token>{{.text = ".WORD",
+                                            .type = TokenType::DIRECTIVE_WORD,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple(".text",
+                        std::vector<Token>{{.text = ".text",
+                                            .type = TokenType::DIRECTIVE_TEXT,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple(
+            ".extern main",
+            std::vector<Token>{
+                {.text = ".extern",
+                 .type = TokenType::DIRECTIVE_EXTERN,
+                 .line_number = 0},
+                {.text = "main", .type = TokenType::IDENTIFIER, .line_number = 0},
+                {.text = "",
+                 .type = TokenType::END_OF_FILE,
+                 .line_number = 1}}),
+
+        std::make_tuple(".bytes",
+                        std::vector<Token>{{.text = ".bytes",
+                                            .type = TokenType::DIRECTIVE,
+                                            .line_number = 0},
+                                           {.text = "",
+                                            .type = TokenType::END_OF_FILE,
+                                            .line_number = 1}}),
+
+        std::make_tuple(
+            "MOV rD, Ra",
+            std::vector<Token>{
+                {.text = "MOV", .type = TokenType::MOV, .line_number = 0},
+                {.text = "rD", .type = TokenType::REGISTER, .line_number = 0},
+                {.text = ",", .type = TokenType::COMMA, .line_number = 0},
+                {.text = "Ra", .type = TokenType::REGISTER, .line_number = 0},
+                {.text = "",
+                 .type = TokenType::END_OF_FILE,
+                 .line_number = 1}}),
+
+        std::make_tuple(
+            "bank #2",
+            std::vector<Token>{
+                {.text = "bank", .type = TokenType::BANK, .line_number = 0},
+                {.text = "#", .type = TokenType::HASH, .line_number = 0},
+                {.text = "2", .type = TokenType::NUMBER, .line_number = 0},
+                {.text = "",
+                 .type = TokenType::END_OF_FILE,
+                 .line_number = 1}})));
@@ -0,0 +1,174 @@
+#include "dlw1_linker/linker.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_assembler/object_file.hpp"
+#include "dlw1_linker/sharded_map.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static LinkInput AssembleInput(const std::string& name,
+                               const std::string& source) {
+  Assembler assembler;
+  return {.name = name, .object = assembler.AssembleObject(source)};
+}
+
+TEST(ObjectFileTest, RecordsSymbolsAndRelocations) {
+  Assembler assembler;
+  const ObjectFile object = assembler.AssembleObject(
+      ".global start\n"
+      ".extern count\n"
+      "start: load ra, #count\n"
+      "loop:  jumpnz loop\n"
+      ".data\n"
+      "value: .byte 7\n");
+
+  EXPECT_EQ(object.Contents(Section::TEXT).size(), 4);
+  EXPECT_EQ(object.Contents(Section::DATA), std::vector<uint8_t>{7});
+
+  ASSERT_EQ(object.symbols.size(), 4);
+  EXPECT_EQ(object.symbols[0].name, "start");
+  EXPECT_EQ(object.symbols[0].binding, SymbolBinding::GLOBAL);
+  EXPECT_EQ(object.symbols[1].binding, SymbolBinding::LOCAL);
+  EXPECT_EQ(object.symbols[2].section, Section::DATA);
+  EXPECT_EQ(object.symbols[3].name, "count");
+  EXPECT_EQ(object.symbols[3].binding, SymbolBinding::EXTERN);
+
+  ASSERT_EQ(object.relocations.size(), 2);
+  EXPECT_EQ(object.relocations[0].type, RelocationType::ABSOLUTE_8);
+  EXPECT_EQ(object.relocations[0].symbol, 3);
+  EXPECT_EQ(object.relocations[1].type, RelocationType::RELATIVE_9);
+  EXPECT_EQ(object.relocations[1].offset, 2);
+}
+
+TEST(ObjectFileTest, SerializationRoundTrips) {
+  Assembler assembler;
+  const ObjectFile object = assembler.AssembleObject(
+      ".extern f\nmain: jump f\nload rb, #main\n.data\n.word 0x1234\n");
+
+  std::vector<uint8_t> bytes(object.SerializedSize());
+  object.Serialize(bytes);
+  ASSERT_TRUE(ObjectFile::IsObject(bytes));
+
+  const ObjectFile copy = ObjectFile::Deserialize(bytes);
+  EXPECT_EQ(copy.sections, object.sections);
+  ASSERT_EQ(copy.symbols.size(), object.symbols.size());
+  for (std::size_t i = 0; i < object.symbols.size(); ++i) {
+    EXPECT_EQ(copy.symbols[i].name, object.symbols[i].name);
+    EXPECT_EQ(copy.symbols[i].binding, object.symbols[i].binding);
+    EXPECT_EQ(copy.symbols[i].offset, object.symbols[i].offset);
+  }
+  ASSERT_EQ(copy.relocations.size(), object.relocations.size());
+
+  bytes.pop_back();
+  EXPECT_THROW(static_cast<void>(ObjectFile::Deserialize(bytes)),
+               std::runtime_error);
+}
+
+TEST(ObjectFileTest, RejectsInvalidDeclarations) {
+  Assembler assembler;
+  EXPECT_THROW(static_cast<void>(assembler.AssembleObject("jump nowhere")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(assembler.AssembleObject(".global missing")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(
+                   assembler.AssembleObject(".extern here\nhere: halt")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(assembler.AssembleObject(".global #1")),
+               std::runtime_error);
+}
+
+TEST(LinkerTest, MatchesSingleFileAssembly) {
+  const std::string source =
+      "start: load ra, #count\n"
+      "loop:  sub ra, #1, ra\n"
+      "       jumpnz loop\n"
+      "       halt\n"
+      ".data\n"
+      "count: .byte 5\n";
+
+  Assembler assembler;
+  const std::vector<LinkInput> inputs{AssembleInput("program.s", source)};
+  EXPECT_EQ(Linker::Link(inputs, 1), assembler.Assemble(source));
+}
+
+TEST(LinkerTest, ResolvesSymbolsAcrossFiles) {
+  const std::vector<LinkInput> inputs{
+      AssembleInput("main.s",
+                    ".extern helper, value\n"
+                    "load ra, #value\n"
+                    "jump helper\n"),
+      AssembleInput("helper.s",
+                    ".global helper, value\n"
+                    "helper: halt\n"
+                    ".data\n"
+                    "value: .byte 9\n")};
+
+  const std::vector<uint8_t> image = Linker::Link(inputs, 2);
+  // main text at 0, helper text at 4, helper data at 6
+  EXPECT_EQ(image, (std::vector<uint8_t>{0x06, 0x05, 0x00, 0x19, 0xFF, 0x08,
+                                         0x09}));
+}
+
+TEST(LinkerTest, KeepsSmallSectionsWithinABank) {
+  std::string filler;
+  for (int i = 0; i < 100; ++i) {
+    filler += "halt\n";
+  }
+  const std::vector<LinkInput> inputs{
+      AssembleInput("a.s", filler), AssembleInput("b.s", filler),
+      AssembleInput("c.s", ".global c\nc: jump c\n")};
+
+  const std::vector<uint8_t> image = Linker::Link(inputs, 0);
+  // b would straddle the first bank boundary, so it starts bank 1
+  ASSERT_EQ(image.size(), 0x100 + 202);
+  EXPECT_EQ(image[200], 0x00);
+  EXPECT_EQ(image[0x100], 0xFF);
+  EXPECT_EQ(image[0x100 + 200], 0xFF);  // jump (-#2) to itself
+  EXPECT_EQ(image[0x100 + 201], 0x19);
+}
+
+TEST(LinkerTest, RejectsUnresolvableSymbols) {
+  const std::vector<LinkInput> undefined{
+      AssembleInput("main.s", ".extern missing\njump missing\n")};
+  EXPECT_THROW(static_cast<void>(Linker::Link(undefined, 0)),
+               std::runtime_error);
+
+  const std::vector<LinkInput> duplicate{
+      AssembleInput("a.s", ".global f\nf: halt\n"),
+      AssembleInput("b.s", ".global f\nf: halt\n")};
+  EXPECT_THROW(static_cast<void>(Linker::Link(duplicate, 0)),
+               std::runtime_error);
+}
+
+TEST(ShardedMapTest, KeepsFirstValueUnderConcurrentInserts) {
+  ShardedMap<int, int> map;
+  constexpr int THREADS = 8;
+  constexpr int KEYS = 1000;
+
+  {
+    std::vector<std::jthread> threads;
+    for (int thread = 0; thread < THREADS; ++thread) {
+      threads.emplace_back([&map, thread] {
+        for (int key = 0; key < KEYS; ++key) {
+          static_cast<void>(map.TryEmplace(key, thread));
+        }
+      });
+    }
+  }
+
+  EXPECT_EQ(map.Size(), KEYS);
+  const auto [value, inserted] = map.TryEmplace(0, -1);
+  EXPECT_FALSE(inserted);
+  EXPECT_GE(value, 0);
+  EXPECT_FALSE(map.Find(KEYS).has_value());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -1,5 +1,8 @@
 #include "dlw1_emulator/memory.hpp"
 
+#include <cstdint>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -26,4 +29,131 @@ TEST(MemoryReadWriteTest, ReadWriteDifferentBanks) {
   EXPECT_EQ(memory.ReadByte(128), 25);
 }
 
+TEST(MemoryReadWriteTest, AllocatesBanksOnFirstWrite) {
+  Memory memory{255};
+  EXPECT_EQ(memory.GetAllocatedBanks(), 0);
+  EXPECT_EQ(memory.ReadByte(254, 17), 0);
+
+  memory.SetCurrentBank(254);
+  memory.WriteByte(17, 0);
+  EXPECT_EQ(memory.GetAllocatedBanks(), 0);
+
+  memory.WriteByte(17, 3);
+  EXPECT_EQ(memory.GetAllocatedBanks(), 1);
+  EXPECT_EQ(memory.ReadByte(17), 3);
+  EXPECT_EQ(memory.ReadByte(254, 18), 0);
+  EXPECT_EQ(memory.ReadByte(253, 17), 0);
+  EXPECT_GE(memory.GetAllocatedBytes(), BANK_SIZE);
+  // One bank plus the bank tables, far from the 255 banks of eager allocation
+  EXPECT_LT(memory.GetAllocatedBytes(), 255 * BANK_SIZE / 4);
+}
+
+TEST(MemoryReadWriteTest, CopiesSharedBanksOnWrite) {
+  Memory original{3};
+  original.WriteByte(10, 1);
+  original.SetCurrentBank(1);
+  original.WriteByte(20, 2);
+
+  const Memory::SharedBanks shared = original.Share();
+  ASSERT_EQ(shared.size(), 3);
+  EXPECT_NE(shared[0], nullptr);
+  EXPECT_NE(shared[1], nullptr);
+  EXPECT_EQ(shared[2], nullptr);
+  EXPECT_EQ(original.GetAllocatedBanks(), 0);
+
+  Memory copy{shared};
+  EXPECT_EQ(copy.GetNumBanks(), 3);
+  EXPECT_EQ(copy.ReadByte(0, 10), 1);
+  EXPECT_EQ(copy.ReadByte(1, 20), 2);
+
+  // Rewriting a value keeps the bank shared
+  copy.WriteByte(10, 1);
+  EXPECT_EQ(copy.GetAllocatedBanks(), 0);
+
+  copy.WriteByte(11, 5);
+  EXPECT_EQ(copy.GetAllocatedBanks(), 1);
+  EXPECT_EQ(copy.ReadByte(11), 5);
+  EXPECT_EQ(copy.ReadByte(10), 1);
+  EXPECT_EQ(original.ReadByte(0, 11), 0);
+
+  original.SetCurrentBank(1);
+  original.WriteByte(20, 7);
+  EXPECT_EQ(original.ReadByte(20), 7);
+  EXPECT_EQ(copy.ReadByte(1, 20), 2);
+  EXPECT_EQ(shared[1]->at(20), 2);
+}
+
+TEST(MemoryReadWriteTest, FaultsOnDeniedAccess) {
+  Memory memory{2};
+  memory.WriteByte(5, 42);
+  memory.SetAccess(0, BankAccess::READ | BankAccess::EXECUTE);
+  EXPECT_EQ(memory.GetAllocatedBanks(), 0);
+
+  memory.WriteByte(5, 43);
+  EXPECT_EQ(memory.ReadByte(5), 42);
+  ASSERT_TRUE(memory.GetFault());
+  EXPECT_EQ(memory.GetFault()->bank, 0);
+  EXPECT_EQ(memory.GetFault()->addr, 5);
+  EXPECT_EQ(memory.GetFault()->access, BankAccess::WRITE);
+  EXPECT_EQ(memory.LoadByte(5), 42);
+  memory.ClearFault();
+
+  memory.SetCurrentBank(1);
+  memory.SetAccess(1, BankAccess::WRITE);
+  memory.WriteByte(6, 7);
+  EXPECT_FALSE(memory.GetFault());
+  EXPECT_EQ(memory.LoadByte(6), 0);
+  ASSERT_TRUE(memory.GetFault());
+  EXPECT_EQ(memory.GetFault()->access, BankAccess::READ);
+  EXPECT_EQ(memory.ReadByte(6), 7);
+}
+
+TEST(MemoryReadWriteTest, LoadsBytesAcrossBanks) {
+  Memory memory{4};
+  std::vector<uint8_t> image(3 * BANK_SIZE);
+  image[0x0FF] = 1;
+  image[0x100] = 2;
+  memory.LoadBytes(0x0100, image);
+
+  EXPECT_EQ(memory.ReadByte(1, 0xFF), 1);
+  EXPECT_EQ(memory.ReadByte(2, 0x00), 2);
+  EXPECT_EQ(memory.ReadByte(3, 0xFF), 0);
+  EXPECT_EQ(memory.GetCurrentBank(), 0);
+  // Bank 0 is not loaded and bank 3 only gets zeros
+  EXPECT_EQ(memory.GetAllocatedBanks(), 2);
+}
+
+TEST(MemoryReadWriteTest, ReportsWatchedWrites) {
+  Memory memory{2};
+  memory.WriteByte(0x10, 1);
+  memory.SetCurrentBank(1);
+  memory.WriteByte(0x10, 1);
+  memory.Watch(1, 0x20, true);
+
+  // Other banks keep the fast path; the watched one gives its bank back
+  EXPECT_EQ(memory.GetAllocatedBanks(), 1);
+  memory.WriteByte(0x21, 7);
+  EXPECT_FALSE(memory.GetWatchHit());
+  memory.WriteByte(0x20, 9);
+  ASSERT_TRUE(memory.GetWatchHit());
+  EXPECT_EQ(memory.GetWatchHit()->old_value, 0);
+  EXPECT_EQ(memory.GetWatchHit()->new_value, 9);
+  EXPECT_EQ(memory.ReadByte(0x21), 7);
+  EXPECT_EQ(memory.GetAllocatedBanks(), 1);
+
+  // Restoring older contents keeps the watchpoint
+  const Memory::SharedBanks earlier = Memory{2}.Share();
+  memory.Restore(earlier);
+  EXPECT_FALSE(memory.GetWatchHit());
+  EXPECT_EQ(memory.ReadByte(0x20), 0);
+  EXPECT_TRUE(memory.IsWatched(1, 0x20));
+  memory.WriteByte(0x20, 9);
+  EXPECT_TRUE(memory.GetWatchHit());
+
+  memory.ClearWatchHit();
+  memory.Watch(1, 0x20, false);
+  memory.WriteByte(0x20, 3);
+  EXPECT_FALSE(memory.GetWatchHit());
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
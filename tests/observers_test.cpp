@@ -0,0 +1,80 @@
+#include "dlw1_emulator/observers.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+// Records every hook call
+struct RecordingObserver : ExecutionObserver {
+  std::vector<uint8_t> reads;
+  std::vector<MemoryWrite> writes;
+  std::vector<uint8_t> banks;
+
+  void OnMemRead(const uint8_t /*bank*/, const uint8_t addr,
+                 const uint8_t value) noexcept {
+    reads.push_back(addr);
+    reads.push_back(value);
+  }
+  void OnMemWrite(const MemoryWrite& write) noexcept {
+    writes.push_back(write);
+  }
+  void OnBankSwitch(const uint8_t from, const uint8_t to) noexcept {
+    banks.push_back(from);
+    banks.push_back(to);
+  }
+};
+
+TEST(ObserversTest, ReportsAccessesToEveryObserver) {
+  Memory memory{2};
+  memory.WriteByte(15, 42);
+  RecordingObserver first;
+  RecordingObserver second;
+  ObservedMemory<RecordingObserver, RecordingObserver> observed{
+      memory, first, second};
+
+  Cpu cpu{{0, 0, 0, 0}, 0, 0, 0, false};
+  cpu.Execute({AddressingMode::IMMEDIATE, Opcode::LOAD, RegisterId::NONE,
+               RegisterId::NONE, RegisterId::A, 15, 0},
+              observed);
+  cpu.Execute({AddressingMode::NONE, Opcode::LOAD, RegisterId::NONE,
+               RegisterId::NONE, RegisterId::NONE, 1, 0},
+              observed);
+  // The second store changes nothing
+  cpu.Execute({AddressingMode::IMMEDIATE, Opcode::STORE, RegisterId::A,
+               RegisterId::NONE, RegisterId::NONE, 200, 0},
+              observed);
+  cpu.Execute({AddressingMode::IMMEDIATE, Opcode::STORE, RegisterId::A,
+               RegisterId::NONE, RegisterId::NONE, 200, 0},
+              observed);
+
+  EXPECT_EQ(second.reads, (std::vector<uint8_t>{15, 42}));
+  EXPECT_EQ(second.banks, (std::vector<uint8_t>{0, 1}));
+  ASSERT_EQ(second.writes.size(), 2);
+  EXPECT_EQ(second.writes[0].bank, 1);
+  EXPECT_EQ(second.writes[0].addr, 200);
+  EXPECT_EQ(second.writes[0].old_value, 0);
+  EXPECT_EQ(second.writes[0].new_value, 42);
+  EXPECT_EQ(second.writes[1].old_value, second.writes[1].new_value);
+  EXPECT_EQ(first.writes.size(), second.writes.size());
+  EXPECT_EQ(memory.ReadByte(1, 200), 42);
+}
+
+TEST(ObserversTest, ReportsDeniedWritesAsUnchanged) {
+  Memory memory{1};
+  memory.SetAccess(0, BankAccess::READ);
+  RecordingObserver observer;
+  ObservedMemory<RecordingObserver> observed{memory, observer};
+
+  observed.WriteByte(7, 9);
+  ASSERT_EQ(observer.writes.size(), 1);
+  EXPECT_EQ(observer.writes[0].new_value, 0);
+  EXPECT_TRUE(memory.GetFault());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -0,0 +1,145 @@
+#include "dlw1_assembler/optimizer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_emulator/cpu.hpp"
+#include "dlw1_emulator/memory.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+struct MachineState {
+  std::array<uint8_t, 4> registers;
+  uint8_t data;  // Last image byte, where programs keep their variable
+
+  bool operator==(const MachineState&) const = default;
+};
+
+// Runs a single-bank image until it halts
+static MachineState RunProgram(const std::vector<uint8_t>& image) {
+  Memory memory;
+  for (std::size_t addr = 0; addr < image.size(); ++addr) {
+    memory.WriteByte(static_cast<uint8_t>(addr), image[addr]);
+  }
+
+  Cpu cpu;
+  for (int cycle = 0; cycle < 10000 && !cpu.GetHalted(); ++cycle) {
+    cpu.Fetch(memory);
+    if (!cpu.GetHalted()) {
+      cpu.Execute(cpu.Decode(), memory);
+    }
+  }
+
+  MachineState state{};
+  for (std::size_t i = 0; i < state.registers.size(); ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    state.registers[i] = cpu.GetRegister(static_cast<RegisterId>(i));
+  }
+  state.data = memory.ReadByte(static_cast<uint8_t>(image.size() - 1));
+  return state;
+}
+
+class OptimizerTest
+    : public ::testing::TestWithParam<std::tuple<std::string,  // Source
+                                                 std::size_t,  // Eliminated
+                                                 std::size_t>> {};  // Size
+
+TEST_P(OptimizerTest, PreservesBehavior) {
+  const auto& [source, expected_eliminated, expected_size] = GetParam();
+
+  Assembler plain;
+  const std::vector<uint8_t> plain_image = plain.Assemble(source);
+
+  Assembler optimizing;
+  optimizing.SetOptimization(true);
+  const std::vector<uint8_t> optimized_image = optimizing.Assemble(source);
+
+  EXPECT_EQ(optimizing.GetStats().eliminated_instructions,
+            expected_eliminated);
+  EXPECT_EQ(optimized_image.size(), expected_size);
+
+  EXPECT_EQ(RunProgram(optimized_image), RunProgram(plain_image));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Patterns, OptimizerTest,
+    ::testing::Values(
+        // mov to self
+        std::make_tuple("add ra, #3, ra\nmov ra, ra\nhalt\n", 1, 4),
+        // add #0 whose flags are overwritten, then one whose flags are read
+        std::make_tuple("add rb, #0, rb\nadd ra, rb, ra\nsub ra, #0, ra\n"
+                        "jumpz done\nadd rc, #1, rc\ndone: halt\n",
+                        1, 10),
+        // add #0 into another register becomes a mov
+        std::make_tuple("add ra, #7, ra\nadd ra, #0, rb\nhalt\n", 0, 6),
+        // load after store, into the same and into another register, and a
+        // store overwritten by the next one
+        std::make_tuple("add ra, #9, ra\nstore ra, #value\nload ra, #value\n"
+                        "store ra, #value\nload rb, #value\nhalt\n"
+                        "value: .byte 0\n",
+                        2, 9),
+        // chained immediates fold, and folding to zero removes the add
+        std::make_tuple("add ra, #5, rb\nsub rb, #2, rb\nadd rb, #1, rb\n"
+                        "add rc, #200, rc\nadd rc, #56, rc\nhalt\n",
+                        4, 4),
+        // a label splits the window: the loop body must stay intact
+        std::make_tuple("add ra, #3, ra\nloop: sub ra, #1, ra\n"
+                        "jumpnz loop\nhalt\n",
+                        0, 8),
+        // a numeric load address would point past the data once the mov
+        // is removed
+        std::make_tuple("load ra, #6\nmov rb, rb\nhalt\n.byte 5\n", 0, 7),
+        // so could a pointer computed from a number, but the size-keeping
+        // store/load rewrite still applies
+        std::make_tuple("add ra, #12, ra\nload rb, ra\nstore rb, #value\n"
+                        "load rc, #value\nmov rd, rd\nhalt\n"
+                        ".byte 7\nvalue: .byte 0\n",
+                        0, 14)));
+
+TEST(OptimizerTest, KeepsLayoutOfProgramsWithNumericJumps) {
+  Assembler assembler;
+  assembler.SetOptimization(true);
+  const std::vector<uint8_t> image =
+      assembler.Assemble("mov ra, ra\njump #0x04\nhalt\n");
+  EXPECT_EQ(assembler.GetStats().eliminated_instructions, 0);
+  EXPECT_EQ(image.size(), 6);
+}
+
+TEST(OptimizerTest, KeepsAddressesBeforeBankSwitchesAndOrg) {
+  // Folding the adds would move the bank switch, and with it the address
+  // execution resumes at in bank 1; the flags also survive the switch
+  const std::string banked =
+      "load ra, #value\nsub ra, #1, ra\nadd rb, #1, rb\nadd rb, #0, rb\n"
+      "bank #1\nadd rc, rc, rc\n.org 0x10A\njumpz done\nadd rd, #5, rd\n"
+      "done: halt\n.org 0x20\nvalue: .byte 1\n";
+  Assembler plain;
+  Assembler optimizing;
+  optimizing.SetOptimization(true);
+  EXPECT_EQ(optimizing.Assemble(banked), plain.Assemble(banked));
+  EXPECT_EQ(optimizing.GetStats().eliminated_instructions, 0);
+
+  // Code after the last .org may still shrink
+  const std::string org = "mov ra, ra\nhalt\n.org 0x10\nmov rb, rb\nhalt\n";
+  EXPECT_EQ(optimizing.Assemble(org).size(), 0x12);
+  EXPECT_EQ(optimizing.GetStats().eliminated_instructions, 1);
+}
+
+TEST(OptimizerTest, KeepsCachedStatementsIntact) {
+  const std::string source = "start: mov rb, rb\nadd ra, #1, ra\nhalt\n";
+  Assembler assembler;
+  assembler.SetOptimization(true);
+  EXPECT_EQ(assembler.Assemble(source).size(), 4);
+
+  // The removed line's label still resolves, and a plain run sees it again
+  assembler.SetOptimization(false);
+  EXPECT_EQ(assembler.Assemble(source + "jump start\n").size(), 8);
+  EXPECT_EQ(assembler.GetStats().parsed_lines, 1);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
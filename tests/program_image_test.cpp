@@ -0,0 +1,158 @@
+#include "dlw1_assembler/program_image.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "dlw1_emulator/config.hpp"
+#include "dlw1_emulator/emulator.hpp"
+#include "dlw1_emulator/instruction.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static const std::string PROGRAM =
+    "        load ra, #count\n"
+    ".org 0x100\n"
+    "_start: halt\n"
+    ".data\n"
+    "count:  .byte 3\n";
+
+static std::vector<uint8_t> Serialize(const ProgramImage& image) {
+  std::vector<uint8_t> bytes(image.SerializedSize());
+  image.Serialize(bytes);
+  return bytes;
+}
+
+// Loads a serialized image into a two-bank emulator
+static void LoadImage(Emulator& emulator, const std::vector<uint8_t>& bytes) {
+  const std::filesystem::path image_path =
+      std::filesystem::temp_directory_path() / "dlw1_program_image_test.bin";
+  {
+    std::ofstream image_file(image_path, std::ios::binary);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    image_file.write(reinterpret_cast<const char*>(bytes.data()),
+                     static_cast<std::streamsize>(bytes.size()));
+  }
+  try {
+    emulator.LoadProgram();
+  } catch (...) {
+    std::filesystem::remove(image_path);
+    throw;
+  }
+  std::filesystem::remove(image_path);
+}
+
+static Config TwoBankConfig() {
+  Config config{};
+  config.num_banks = 2;
+  config.program_file_path =
+      (std::filesystem::temp_directory_path() / "dlw1_program_image_test.bin")
+          .string();
+  return config;
+}
+
+TEST(ProgramImageTest, RoundTripsSegments) {
+  const std::vector<uint8_t> code{0x01, 0x01, 0xFF, 0x08};
+  const std::vector<uint8_t> data{0x2A};
+  ProgramImage image;
+  image.entry = 0x0302;
+  image.segments.push_back({0x0300, ImageSegment::READ_ONLY, code});
+  image.segments.push_back({0x1000, 0, data});
+
+  const std::vector<uint8_t> bytes = Serialize(image);
+  ASSERT_TRUE(ProgramImage::IsImage(bytes));
+  EXPECT_EQ(bytes.size(), ProgramImage::HEADER_SIZE +
+                              (2 * ProgramImage::SEGMENT_SIZE) + 5);
+
+  const ProgramImage loaded = ProgramImage::Deserialize(bytes);
+  EXPECT_EQ(loaded.entry, 0x0302);
+  ASSERT_EQ(loaded.segments.size(), 2);
+  EXPECT_EQ(loaded.segments[0].address, 0x0300);
+  EXPECT_EQ(loaded.segments[0].flags, ImageSegment::READ_ONLY);
+  EXPECT_EQ(std::vector<uint8_t>(loaded.segments[0].bytes.begin(),
+                                 loaded.segments[0].bytes.end()),
+            code);
+  EXPECT_EQ(loaded.segments[1].address, 0x1000);
+  EXPECT_EQ(loaded.segments[1].bytes.size(), 1);
+}
+
+TEST(ProgramImageTest, RejectsCorruptImages) {
+  const std::vector<uint8_t> code{0xFF, 0x08};
+  ProgramImage image;
+  image.segments.push_back({0xFFFE, 0, code});
+  std::vector<uint8_t> bytes = Serialize(image);
+  EXPECT_NO_THROW(static_cast<void>(ProgramImage::Deserialize(bytes)));
+
+  bytes.back() ^= 1U;
+  EXPECT_THROW(static_cast<void>(ProgramImage::Deserialize(bytes)),
+               std::runtime_error);
+
+  image.segments[0].address = 0xFFFF;
+  bytes = Serialize(image);
+  EXPECT_THROW(static_cast<void>(ProgramImage::Deserialize(bytes)),
+               std::runtime_error);
+
+  bytes = Serialize(image);
+  bytes.pop_back();
+  EXPECT_THROW(static_cast<void>(ProgramImage::Deserialize(bytes)),
+               std::runtime_error);
+}
+
+TEST(ProgramImageTest, AssemblesOrgGapsIntoSegments) {
+  Assembler assembler;
+  assembler.SetReadOnlyText(true);
+  const std::vector<uint8_t> bytes = assembler.AssembleImage(PROGRAM);
+  const ProgramImage image = ProgramImage::Deserialize(bytes);
+
+  // The 254-byte gap before .org 0x100 is not stored
+  EXPECT_EQ(image.entry, 0x100);
+  ASSERT_EQ(image.segments.size(), 3);
+  EXPECT_EQ(image.segments[0].address, 0x000);
+  EXPECT_EQ(image.segments[0].bytes.size(), 2);
+  EXPECT_EQ(image.segments[0].flags, ImageSegment::READ_ONLY);
+  EXPECT_EQ(image.segments[1].address, 0x100);
+  EXPECT_EQ(image.segments[1].bytes[0], 0xFF);
+  EXPECT_EQ(image.segments[1].flags, 0);  // Shares bank 1 with the data
+  EXPECT_EQ(image.segments[2].address, 0x102);
+  EXPECT_EQ(image.segments[2].bytes[0], 3);
+  EXPECT_EQ(image.segments[2].flags, 0);
+  EXPECT_LT(bytes.size(), 0x100);
+}
+
+TEST(ProgramImageTest, RunsReadOnlyTextThatWritesData) {
+  // Bank 0 holds only text and is protected; the code in bank 1 stores to
+  // data next to it, so bank 1 stays writable
+  Assembler assembler;
+  assembler.SetReadOnlyText(true);
+  const std::vector<uint8_t> bytes = assembler.AssembleImage(
+      "_start: bank #1\n.org 0x102\nload ra, #count\nsub ra, #1, ra\n"
+      "store ra, #count\nload rb, #count\nhalt\n.data\ncount: .byte 3\n");
+  const ProgramImage image = ProgramImage::Deserialize(bytes);
+  ASSERT_EQ(image.segments.size(), 3);
+  EXPECT_EQ(image.segments[0].flags, ImageSegment::READ_ONLY);
+  EXPECT_EQ(image.segments[1].flags, 0);
+
+  Emulator emulator{TwoBankConfig()};
+  LoadImage(emulator, bytes);
+  ASSERT_NO_THROW(emulator.Run());
+  EXPECT_EQ(emulator.GetCpu().GetRegister(RegisterId::B), 2);
+}
+
+TEST(ProgramImageTest, RejectsReadOnlySegmentsSharingABank) {
+  const std::vector<uint8_t> code{0xFF, 0x08};
+  const std::vector<uint8_t> data{0x03};
+  ProgramImage image;
+  image.segments.push_back({0x0000, ImageSegment::READ_ONLY, code});
+  image.segments.push_back({0x0010, 0, data});
+
+  Emulator emulator{TwoBankConfig()};
+  EXPECT_THROW(LoadImage(emulator, Serialize(image)), std::runtime_error);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
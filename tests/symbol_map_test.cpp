@@ -0,0 +1,91 @@
+#include "dlw1_assembler/symbol_map.hpp"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dlw1_assembler/assembler.hpp"
+#include "gtest/gtest.h"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+static const std::string PROGRAM =
+    "start:  load ra, #count   ; Counter\n"
+    "\n"
+    "loop:   sub   ra, #1, ra\n"
+    "        jumpnz loop\n"
+    "        halt\n"
+    ".data\n"
+    "count:  .byte 3\n";
+
+static std::vector<uint8_t> Serialize(const DebugInfo& info) {
+  std::vector<uint8_t> bytes(info.SerializedSize());
+  info.Serialize(bytes);
+  return bytes;
+}
+
+TEST(SymbolMapTest, MapsAddressesToSourceLines) {
+  Assembler assembler;
+  static_cast<void>(assembler.Assemble(PROGRAM));
+  const std::vector<uint8_t> bytes =
+      Serialize(assembler.BuildDebugInfo(PROGRAM, "count.s"));
+  const SymbolMap map{bytes};
+  ASSERT_EQ(map.Size(), 5);
+
+  const std::optional<SourceLocation> loop = map.Lookup(0x02);
+  ASSERT_TRUE(loop.has_value());
+  EXPECT_EQ(loop->file, "count.s");
+  EXPECT_EQ(loop->line, 3);
+  EXPECT_EQ(loop->label, "loop");
+  EXPECT_EQ(loop->text, "loop: sub ra, #1, ra");
+
+  // The second byte of an instruction belongs to the same line
+  const std::optional<SourceLocation> jump = map.Lookup(0x05);
+  ASSERT_TRUE(jump.has_value());
+  EXPECT_EQ(jump->text, "jumpnz loop");
+  EXPECT_EQ(jump->label, "loop");
+
+  EXPECT_EQ(map.Lookup(0x08)->text, "count: .byte 3");
+  EXPECT_FALSE(map.Lookup(0x09).has_value());
+}
+
+TEST(SymbolMapTest, BatchLookupKeepsRequestOrder) {
+  Assembler assembler;
+  static_cast<void>(assembler.Assemble(PROGRAM));
+  const std::vector<uint8_t> bytes =
+      Serialize(assembler.BuildDebugInfo(PROGRAM, "count.s"));
+  const SymbolMap map{bytes};
+
+  const std::array<uint16_t, 5> addresses{0x06, 0x00, 0x300, 0x02, 0x06};
+  const std::vector<std::optional<SourceLocation>> locations =
+      map.Lookup(addresses);
+  ASSERT_EQ(locations.size(), addresses.size());
+  for (std::size_t i = 0; i < addresses.size(); ++i) {
+    const std::optional<SourceLocation> single = map.Lookup(addresses.at(i));
+    ASSERT_EQ(locations[i].has_value(), single.has_value());
+    if (single) {
+      EXPECT_EQ(locations[i]->line, single->line);
+    }
+  }
+  EXPECT_EQ(locations[0]->text, "halt");
+  EXPECT_FALSE(locations[2].has_value());
+}
+
+TEST(SymbolMapTest, RejectsCorruptMaps) {
+  const std::vector<uint8_t> bytes =
+      Serialize({.file = "a.s", .lines = {{.address = 0, .size = 2}}});
+  EXPECT_NO_THROW(SymbolMap{bytes});
+
+  std::vector<uint8_t> truncated = bytes;
+  truncated.pop_back();
+  EXPECT_THROW(SymbolMap{truncated}, std::runtime_error);
+
+  std::vector<uint8_t> wrong_magic = bytes;
+  wrong_magic[3] = 'O';
+  EXPECT_THROW(SymbolMap{wrong_magic}, std::runtime_error);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)